@@ -0,0 +1,54 @@
+#include "TileNavClusterRoute.h"
+
+FTileNavClusterRoute::FTileNavClusterRoute(const FTileNavGridConstPtr& InGrid, const TArray<int32>& InNodes, const ETileNavSearchMode InMode):
+	Grid(InGrid), Nodes(InNodes), Mode(InMode), RefinedNodes(0), bFailed(false) {
+
+	if (Grid.IsValid() && Nodes.Num() > 0) {
+		RefinedNodes = 1;
+		Tiles.Add(Nodes[0]);
+	} else {
+		bFailed = true;
+	}
+}
+
+bool FTileNavClusterRoute::RefineAhead(const FVector& Location, FTileNavSearchStats& Stats) {
+	const float Lookahead = Grid.IsValid() ? Grid->Clusters.ClusterExtent * 2.0f : 0.0f;
+	while (!bFailed && !IsRefined() && FVector::Distance(Location, Grid->Locations[Nodes[RefinedNodes - 1]]) < Lookahead) {
+		RefineNext(Stats);
+	}
+	return !bFailed;
+}
+
+bool FTileNavClusterRoute::RefineAll(FTileNavSearchStats& Stats) {
+	while (!bFailed && !IsRefined()) {
+		RefineNext(Stats);
+	}
+	return !bFailed;
+}
+
+void FTileNavClusterRoute::GetPath(TArray<FVector>& OutRefinedTiles, TArray<FVector>& OutWaypoints) const {
+	if (!Grid.IsValid()) {
+		return;
+	}
+	for (const int32 TileIndex: Tiles) {
+		OutRefinedTiles.Add(Grid->Locations[TileIndex]);
+	}
+	for (int32 Node = RefinedNodes; Node < Nodes.Num(); Node++) {
+		OutWaypoints.Add(Grid->Locations[Nodes[Node]]);
+	}
+}
+
+bool FTileNavClusterRoute::RefineNext(FTileNavSearchStats& Stats) {
+
+	// Legs across a border are a single step, and legs within a cluster are short searches between its entrances
+	TArray<int32> LegTiles;
+	if (!Grid->FindPath(Nodes[RefinedNodes - 1], Nodes[RefinedNodes], Mode, LegTiles, Stats)) {
+		bFailed = true;
+		return false;
+	}
+	for (int32 Index = 1; Index < LegTiles.Num(); Index++) {
+		Tiles.Add(LegTiles[Index]);
+	}
+	RefinedNodes++;
+	return true;
+}
@@ -0,0 +1,373 @@
+#include "TileNavClusters.h"
+#include "TileNavGrid.h"
+#include "TileNavSearchState.h"
+
+namespace TileNavClusterSearch {
+
+	struct FNode {
+		float G;
+		int32 Parent;
+		bool bClosed;
+	};
+
+	struct FOpenNode {
+		int32 Tile;
+		float G;
+		float F;
+	};
+
+	struct FLowestF {
+		bool operator()(const FOpenNode& A, const FOpenNode& B) const {
+			return A.F < B.F;
+		}
+	};
+
+	// Scan Length tiles along a border from First in steps of Along, pairing each with the tile Across from it, and add
+	// an entrance for each run of pairs that are both walkable. Wide runs get one at each end so routes hug neither side
+	void AddEntrances(const FTileNavGrid& Grid, const FIntPoint First, const FIntPoint Along, const FIntPoint Across, const int32 Length, TArray<FIntPoint>& OutEntrances) {
+		const auto AddEntrance = [&](const int32 Step) {
+			const FIntPoint Tile = First + Along * Step;
+			OutEntrances.Add(FIntPoint(Grid.GetIndex(Tile.X, Tile.Y), Grid.GetIndex(Tile.X + Across.X, Tile.Y + Across.Y)));
+		};
+		int32 RunStart = INDEX_NONE;
+		for (int32 Step = 0; Step <= Length; Step++) {
+			const FIntPoint Tile = First + Along * Step;
+			const bool bOpen = Step < Length && Grid.IsWalkableAt(Tile.X, Tile.Y) && Grid.IsWalkableAt(Tile.X + Across.X, Tile.Y + Across.Y);
+			if (bOpen && RunStart == INDEX_NONE) {
+				RunStart = Step;
+			} else if (!bOpen && RunStart != INDEX_NONE) {
+				if (Step - RunStart >= FTileNavClusters::WideEntrance) {
+					AddEntrance(RunStart);
+					AddEntrance(Step - 1);
+				} else {
+					AddEntrance((RunStart + Step - 1) / 2);
+				}
+				RunStart = INDEX_NONE;
+			}
+		}
+	}
+}
+
+FTileNavClusters::FTileNavClusters(): ClusterSize(0), ClustersX(0), ClustersY(0), ClusterExtent(0.0f) {
+}
+
+void FTileNavClusters::Build(const FTileNavGrid& Grid, const int32 InClusterSize) {
+	Reset();
+	if (InClusterSize <= 1 || Grid.Num() == 0) {
+		return;
+	}
+	ClusterSize = InClusterSize;
+	ClustersX = FMath::DivideAndRoundUp(Grid.Width, ClusterSize);
+	ClustersY = FMath::DivideAndRoundUp(Grid.Height, ClusterSize);
+	ClusterExtent = FVector::Distance(Grid.GridToWorld(0.0f, 0.0f, 0.0f), Grid.GridToWorld(ClusterSize, 0.0f, 0.0f));
+	Clusters.SetNum(ClustersX * ClustersY);
+
+	// Nodes are gathered from the entrances on all four borders, so every border is built first
+	for (int32 Cluster = 0; Cluster < Clusters.Num(); Cluster++) {
+		BuildEntrances(Grid, Cluster);
+	}
+	for (int32 Cluster = 0; Cluster < Clusters.Num(); Cluster++) {
+		BuildNodes(Grid, Cluster);
+	}
+}
+
+void FTileNavClusters::Reset() {
+	ClusterSize = 0;
+	ClustersX = 0;
+	ClustersY = 0;
+	ClusterExtent = 0.0f;
+	Clusters.Reset();
+}
+
+void FTileNavClusters::Update(const FTileNavGrid& Grid, const TArray<int32>& ChangedTiles) {
+	if (!IsEnabled()) {
+		return;
+	}
+	TSet<int32> EntranceClusters;
+	TSet<int32> NodeClusters;
+	for (const int32 TileIndex: ChangedTiles) {
+		if (!Grid.IsValidTile(TileIndex)) {
+			continue;
+		}
+
+		// Each cluster owns its east and south borders, so the west and north borders belong to its neighbors
+		const int32 Cluster = GetCluster(Grid, TileIndex);
+		const int32 Cx = Cluster % ClustersX;
+		const int32 Cy = Cluster / ClustersX;
+		EntranceClusters.Add(Cluster);
+		NodeClusters.Add(Cluster);
+		if (Cx > 0) {
+			EntranceClusters.Add(Cluster - 1);
+			NodeClusters.Add(Cluster - 1);
+		}
+		if (Cy > 0) {
+			EntranceClusters.Add(Cluster - ClustersX);
+			NodeClusters.Add(Cluster - ClustersX);
+		}
+		if (Cx + 1 < ClustersX) {
+			NodeClusters.Add(Cluster + 1);
+		}
+		if (Cy + 1 < ClustersY) {
+			NodeClusters.Add(Cluster + ClustersX);
+		}
+	}
+	for (const int32 Cluster: EntranceClusters) {
+		BuildEntrances(Grid, Cluster);
+	}
+	for (const int32 Cluster: NodeClusters) {
+		BuildNodes(Grid, Cluster);
+	}
+}
+
+int32 FTileNavClusters::GetCluster(const FTileNavGrid& Grid, const int32 TileIndex) const {
+	const FIntPoint Coord = Grid.GetCoord(TileIndex);
+	return (Coord.Y / ClusterSize) * ClustersX + Coord.X / ClusterSize;
+}
+
+bool FTileNavClusters::IsLongQuery(const FTileNavGrid& Grid, const int32 StartIndex, const int32 EndIndex, const uint8 MinClearance) const {
+	if (!IsEnabled() || MinClearance > 0 || !Grid.IsValidTile(StartIndex) || !Grid.IsValidTile(EndIndex)) {
+		return false;
+	}
+	const FIntPoint StartCoord = Grid.GetCoord(StartIndex) / ClusterSize;
+	const FIntPoint EndCoord = Grid.GetCoord(EndIndex) / ClusterSize;
+	return FMath::Max(FMath::Abs(StartCoord.X - EndCoord.X), FMath::Abs(StartCoord.Y - EndCoord.Y)) > 1;
+}
+
+bool FTileNavClusters::FindRoute(const FTileNavGrid& Grid, const int32 StartIndex, const int32 EndIndex, TArray<int32>& OutRoute, FTileNavSearchStats& Stats) const {
+	using namespace TileNavClusterSearch;
+	if (!IsEnabled() || !Grid.IsValidTile(StartIndex) || !Grid.IsValidTile(EndIndex)) {
+		return false;
+	}
+	const int32 StartCluster = GetCluster(Grid, StartIndex);
+	const int32 EndCluster = GetCluster(Grid, EndIndex);
+	if (StartCluster == EndCluster) {
+		OutRoute.Add(StartIndex);
+		OutRoute.Add(EndIndex);
+		return true;
+	}
+	const double StartTime = FPlatformTime::Seconds();
+
+	// The start and end tiles join the graph through their distances to the nodes of their own clusters
+	TArray<float> StartCosts;
+	TArray<float> EndCosts;
+	ComputeNodeDistances(Grid, StartCluster, StartIndex, StartCosts, Stats);
+	ComputeNodeDistances(Grid, EndCluster, EndIndex, EndCosts, Stats);
+
+	// Graph nodes are keyed by tile index, which is unique since every tile belongs to a single cluster
+	TMap<int32, FNode> Nodes;
+	TArray<FOpenNode> OpenHeap;
+	const auto Open = [&](const int32 Tile, const int32 Parent, const float G) {
+		FNode* Node = Nodes.Find(Tile);
+		if (Node && (Node->bClosed || G >= Node->G)) {
+			return;
+		}
+		if (!Node) {
+			Node = &Nodes.Add(Tile);
+		}
+		Node->G = G;
+		Node->Parent = Parent;
+		Node->bClosed = false;
+		OpenHeap.HeapPush({Tile, G, G + Grid.GetHeuristic(Tile, EndIndex)}, FLowestF());
+	};
+	Open(StartIndex, INDEX_NONE, 0.0f);
+
+	TArray<int32> Crossings;
+	bool bFound = false;
+	while (OpenHeap.Num() > 0) {
+		FOpenNode Current;
+		OpenHeap.HeapPop(Current, FLowestF(), false);
+		FNode& CurrentNode = Nodes[Current.Tile];
+		if (CurrentNode.bClosed || Current.G > CurrentNode.G) {
+			continue;
+		}
+		CurrentNode.bClosed = true;
+		Stats.Expansions++;
+		if (Current.Tile == EndIndex) {
+			bFound = true;
+			break;
+		}
+
+		const int32 Cluster = GetCluster(Grid, Current.Tile);
+		const FTileNavCluster& CurrentCluster = Clusters[Cluster];
+		if (Current.Tile == StartIndex) {
+			for (int32 Node = 0; Node < CurrentCluster.Nodes.Num(); Node++) {
+				if (StartCosts[Node] < MAX_FLT) {
+					Open(CurrentCluster.Nodes[Node], Current.Tile, StartCosts[Node]);
+				}
+			}
+		}
+		const int32 NodeIndex = CurrentCluster.Nodes.IndexOfByKey(Current.Tile);
+		if (NodeIndex == INDEX_NONE) {
+			continue;
+		}
+		for (int32 Node = 0; Node < CurrentCluster.Nodes.Num(); Node++) {
+			const float Cost = CurrentCluster.GetCost(NodeIndex, Node);
+			if (Node != NodeIndex && Cost < MAX_FLT) {
+				Open(CurrentCluster.Nodes[Node], Current.Tile, Current.G + Cost);
+			}
+		}
+		Crossings.Reset();
+		GetCrossings(Cluster, Current.Tile, Crossings);
+		for (const int32 Crossing: Crossings) {
+			Open(Crossing, Current.Tile, Current.G + FVector::Distance(Grid.Locations[Current.Tile], Grid.Locations[Crossing]));
+		}
+		if (Cluster == EndCluster && EndCosts[NodeIndex] < MAX_FLT) {
+			Open(EndIndex, Current.Tile, Current.G + EndCosts[NodeIndex]);
+		}
+	}
+
+	if (bFound) {
+		const int32 RouteIndex = OutRoute.Num();
+		for (int32 Tile = EndIndex; Tile != INDEX_NONE; Tile = Nodes[Tile].Parent) {
+			OutRoute.Insert(Tile, RouteIndex);
+		}
+	}
+	Stats.Milliseconds += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	return bFound;
+}
+
+SIZE_T FTileNavClusters::GetAllocatedSize() const {
+	SIZE_T Size = Clusters.GetAllocatedSize();
+	for (auto& Cluster: Clusters) {
+		Size += Cluster.EastEntrances.GetAllocatedSize() + Cluster.SouthEntrances.GetAllocatedSize() + Cluster.Nodes.GetAllocatedSize() + Cluster.Costs.GetAllocatedSize();
+	}
+	return Size;
+}
+
+void FTileNavClusters::BuildEntrances(const FTileNavGrid& Grid, const int32 Cluster) {
+	FTileNavCluster& Target = Clusters[Cluster];
+	Target.EastEntrances.Reset();
+	Target.SouthEntrances.Reset();
+	const int32 MinX = (Cluster % ClustersX) * ClusterSize;
+	const int32 MinY = (Cluster / ClustersX) * ClusterSize;
+	if (MinX + ClusterSize < Grid.Width) {
+		TileNavClusterSearch::AddEntrances(Grid, FIntPoint(MinX + ClusterSize - 1, MinY), FIntPoint(0, 1), FIntPoint(1, 0), FMath::Min(ClusterSize, Grid.Height - MinY), Target.EastEntrances);
+	}
+	if (MinY + ClusterSize < Grid.Height) {
+		TileNavClusterSearch::AddEntrances(Grid, FIntPoint(MinX, MinY + ClusterSize - 1), FIntPoint(1, 0), FIntPoint(0, 1), FMath::Min(ClusterSize, Grid.Width - MinX), Target.SouthEntrances);
+	}
+}
+
+void FTileNavClusters::BuildNodes(const FTileNavGrid& Grid, const int32 Cluster) {
+	FTileNavCluster& Target = Clusters[Cluster];
+	Target.Nodes.Reset();
+	for (auto& Entrance: Target.EastEntrances) {
+		Target.Nodes.AddUnique(Entrance.X);
+	}
+	for (auto& Entrance: Target.SouthEntrances) {
+		Target.Nodes.AddUnique(Entrance.X);
+	}
+	if (Cluster % ClustersX > 0) {
+		for (auto& Entrance: Clusters[Cluster - 1].EastEntrances) {
+			Target.Nodes.AddUnique(Entrance.Y);
+		}
+	}
+	if (Cluster / ClustersX > 0) {
+		for (auto& Entrance: Clusters[Cluster - ClustersX].SouthEntrances) {
+			Target.Nodes.AddUnique(Entrance.Y);
+		}
+	}
+
+	const int32 NumNodes = Target.Nodes.Num();
+	Target.Costs.SetNumUninitialized(NumNodes * NumNodes);
+	TArray<float> Distances;
+	FTileNavSearchStats Stats;
+	for (int32 Node = 0; Node < NumNodes; Node++) {
+		ComputeNodeDistances(Grid, Cluster, Target.Nodes[Node], Distances, Stats);
+		FMemory::Memcpy(&Target.Costs[Node * NumNodes], Distances.GetData(), NumNodes * sizeof(float));
+	}
+}
+
+void FTileNavClusters::GetCrossings(const int32 Cluster, const int32 NodeTile, TArray<int32>& OutTiles) const {
+	const FTileNavCluster& Source = Clusters[Cluster];
+	for (auto& Entrance: Source.EastEntrances) {
+		if (Entrance.X == NodeTile) {
+			OutTiles.Add(Entrance.Y);
+		}
+	}
+	for (auto& Entrance: Source.SouthEntrances) {
+		if (Entrance.X == NodeTile) {
+			OutTiles.Add(Entrance.Y);
+		}
+	}
+	if (Cluster % ClustersX > 0) {
+		for (auto& Entrance: Clusters[Cluster - 1].EastEntrances) {
+			if (Entrance.Y == NodeTile) {
+				OutTiles.Add(Entrance.X);
+			}
+		}
+	}
+	if (Cluster / ClustersX > 0) {
+		for (auto& Entrance: Clusters[Cluster - ClustersX].SouthEntrances) {
+			if (Entrance.Y == NodeTile) {
+				OutTiles.Add(Entrance.X);
+			}
+		}
+	}
+}
+
+void FTileNavClusters::ComputeNodeDistances(const FTileNavGrid& Grid, const int32 Cluster, const int32 StartIndex, TArray<float>& OutDistances, FTileNavSearchStats& Stats) const {
+	const FTileNavCluster& Target = Clusters[Cluster];
+	OutDistances.Init(MAX_FLT, Target.Nodes.Num());
+	if (Target.Nodes.Num() == 0 || !Grid.IsWalkable(StartIndex)) {
+		return;
+	}
+
+	// Dijkstra over the cluster's own tiles, with search state indexed within the cluster rather than the section
+	const int32 MinX = (Cluster % ClustersX) * ClusterSize;
+	const int32 MinY = (Cluster / ClustersX) * ClusterSize;
+	const int32 SizeX = FMath::Min(ClusterSize, Grid.Width - MinX);
+	const int32 SizeY = FMath::Min(ClusterSize, Grid.Height - MinY);
+	TileNavSearch::FSearchState& Search = TileNavSearch::GetThreadSearchState();
+	Search.Reset(SizeX * SizeY);
+	const FIntPoint StartCoord = Grid.GetCoord(StartIndex);
+	Search.Open((StartCoord.Y - MinY) * SizeX + StartCoord.X - MinX, INDEX_NONE, 0.0f, 0.0f);
+
+	int32 RemainingNodes = Target.Nodes.Num();
+	FPathTile CurrentPathTile;
+	while (RemainingNodes > 0 && Search.PopBest(CurrentPathTile)) {
+		Stats.Expansions++;
+		const FIntPoint Coord(MinX + CurrentPathTile.Index % SizeX, MinY + CurrentPathTile.Index / SizeX);
+		const int32 TileIndex = Grid.GetIndex(Coord.X, Coord.Y);
+		const int32 Node = Target.Nodes.IndexOfByKey(TileIndex);
+		if (Node != INDEX_NONE) {
+			OutDistances[Node] = CurrentPathTile.G;
+			RemainingNodes--;
+		}
+		const FVector& CurrentLocation = Grid.Locations[TileIndex];
+		const uint8 Mask = Grid.NeighborMasks[TileIndex];
+		for (int32 Direction = 0; Direction < 8; Direction++) {
+			if (!(Mask & (1 << Direction))) {
+				continue;
+			}
+			const FIntPoint ChildCoord = Coord + FTileNavGrid::DirectionOffsets[Direction];
+			const int32 ChildIndex = TileIndex + Grid.NeighborOffsets[Direction];
+			if (ChildCoord.X < MinX || ChildCoord.Y < MinY || ChildCoord.X >= MinX + SizeX || ChildCoord.Y >= MinY + SizeY || !Grid.IsWalkable(ChildIndex)) {
+				continue;
+			}
+			Search.Open(
+				(ChildCoord.Y - MinY) * SizeX + ChildCoord.X - MinX,
+				CurrentPathTile.Index,
+				CurrentPathTile.G + FVector::Distance(Grid.Locations[ChildIndex], CurrentLocation),
+				0.0f
+			);
+		}
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FTileNavCluster& Cluster) {
+	Ar << Cluster.EastEntrances;
+	Ar << Cluster.SouthEntrances;
+	Cluster.Nodes.BulkSerialize(Ar);
+	Cluster.Costs.BulkSerialize(Ar);
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FTileNavClusters& Clusters) {
+	Ar << Clusters.ClusterSize;
+	Ar << Clusters.ClustersX;
+	Ar << Clusters.ClustersY;
+	Ar << Clusters.ClusterExtent;
+	Ar << Clusters.Clusters;
+	return Ar;
+}
@@ -1,13 +1,17 @@
 #include "TileNavComponent.h"
 #include "TileNavStructs.h"
+#include "TileNavigationData.h"
 #include "GameFramework/Character.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Async/ParallelFor.h"
+#include "EngineUtils.h"
 
 UTileNavComponent::UTileNavComponent(const FObjectInitializer& ObjectInitializer) {
 	PrimaryComponentTick.bCanEverTick = true;
 	BodyInstance.SetCollisionProfileName("BlockAll");
 	CollisionTraceNormalArrow = ObjectInitializer.CreateDefaultSubobject<UArrowComponent>(this, TEXT("CollisionTraceNormal"));
+	Grid = MakeShared<FTileNavGrid, ESPMode::ThreadSafe>();
 }
 
 void UTileNavComponent::OnComponentCreated() {
@@ -16,24 +20,121 @@ void UTileNavComponent::OnComponentCreated() {
 	CollisionTraceNormalArrow->SetRelativeRotation(FRotator(FQuat(CollisionTraceNormal) * FQuat(FRotator(90.f,90.f,90.f))));
 }
 
+void UTileNavComponent::OnRegister() {
+	Super::OnRegister();
+	MarkNavigationDirty();
+}
+
+void UTileNavComponent::OnUnregister() {
+
+	// The navigation data removes the section on its next tick, unless the component has been registered again by then
+	MarkNavigationDirty();
+	Super::OnUnregister();
+}
+
+void UTileNavComponent::OnUpdateTransform(const EUpdateTransformFlags UpdateTransformFlags, const ETeleportType Teleport) {
+	Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
+	MarkNavigationDirty();
+}
+
+bool UTileNavComponent::SetStaticMesh(UStaticMesh* NewMesh) {
+	const bool bChanged = Super::SetStaticMesh(NewMesh);
+	if (bChanged) {
+		MarkNavigationDirty();
+	}
+	return bChanged;
+}
+
+#if WITH_EDITOR
+void UTileNavComponent::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) {
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	FProperty* Property = PropertyChangedEvent.Property;
+	const FString PropertyName = Property != nullptr ? Property->GetFName().ToString() : "";
+
+	const TSet<FString> BuildProperties = {
+		"GridSize",
+		"CollisionTraceNormal",
+		"IgnoreComponents",
+	};
+	if (BuildProperties.Contains(PropertyName)) {
+		MarkNavigationDirty();
+	}
+}
+#endif
+
+void UTileNavComponent::MarkNavigationDirty() {
+
+	// Editor worlds are rebuilt in full by the navigation data, so only game worlds track dirty sections
+	UWorld* World = GetWorld();
+	if (!World || !World->IsGameWorld() || World->bIsTearingDown) {
+		return;
+	}
+	if (!NavigationData.IsValid()) {
+		for (TActorIterator<ATileNavigationData> It(World); It; ++It) {
+			NavigationData = *It;
+			break;
+		}
+	}
+	if (NavigationData.IsValid()) {
+		NavigationData->MarkComponentDirty(this);
+	}
+}
+
+void UTileNavComponent::SetGridSize(const float NewGridSize) {
+	if (GridSize != NewGridSize) {
+		GridSize = NewGridSize;
+		MarkNavigationDirty();
+	}
+}
+
+void UTileNavComponent::SetCollisionTraceNormal(const FRotator NewCollisionTraceNormal) {
+	if (!CollisionTraceNormal.Equals(NewCollisionTraceNormal)) {
+		CollisionTraceNormal = NewCollisionTraceNormal;
+		CollisionTraceNormalArrow->SetRelativeRotation(FRotator(FQuat(CollisionTraceNormal) * FQuat(FRotator(90.f,90.f,90.f))));
+		MarkNavigationDirty();
+	}
+}
+
+void UTileNavComponent::SetIgnoreComponents(const TArray<UPrimitiveComponent*>& NewIgnoreComponents) {
+	IgnoreComponents = NewIgnoreComponents;
+	MarkNavigationDirty();
+}
+
 void UTileNavComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 }
 
-void UTileNavComponent::BuildNavigationTiles(const float GridScale, const float Clearance) {
+void UTileNavComponent::BuildNavigationTiles(const float GridScale, const float WalkableClearance, const float MaxClearance, const bool bParallel, FTileNavBuildStats& BuildStats) {
+	Grid = MakeShared<FTileNavGrid, ESPMode::ThreadSafe>();
 	if (GetStaticMesh() == nullptr) return;
-	Tiles.Empty();
 	float Interval = GridScale * GridSize / GetComponentScale().Z;
 	FVector Min, Max;
 	GetLocalBounds(Min, Max);
 	const int32 Width = FMath::CeilToInt(((Max - Min) / Interval).X);
 	const int32 Height = FMath::CeilToInt(((Max - Min) / Interval).Y);
-	TArray<FTileTraceVertex> TraceVertices;
-	TMap<FIntPoint, FVector> WalkableTiles;
-	TArray<int32> EdgeTileIndices;
 	float MinDepth = FMath::Min3(Min.X, Min.Y, Min.Z);
 	float MaxDepth = FMath::Max3(Max.X, Max.Y, Max.Z);
-	for (int32 Y = 0; Y < Height; Y++) {
+	const FTransform ComponentTransform = GetComponentTransform();
+	const FQuat TraceRotation = CollisionTraceNormal.Quaternion();
+
+	// Each tile sits between four trace vertices, so the tile grid is one smaller than the trace grid on each axis
+	FTileNavGrid& BuildGrid = *Grid;
+	BuildGrid.Init(
+		Width - 1,
+		Height - 1,
+		ComponentTransform,
+		TraceRotation,
+		FVector2D(Min.X + Interval, Min.Y + Interval),
+		Interval
+	);
+	BuildGrid.ClearanceStep = Interval * ComponentTransform.GetScale3D().GetAbsMin() / FTileNavGrid::ClearanceStepsPerTile;
+	BuildGrid.WalkableClearance = WalkableClearance;
+
+	// Trace phase. Every vertex is written to its own slot, so rows can be traced on any thread
+	double PhaseStartTime = FPlatformTime::Seconds();
+	TArray<FTileTraceVertex> TraceVertices;
+	TraceVertices.SetNum(FMath::Max(Width * Height, 0));
+	ParallelFor(FMath::Max(Height, 0), [&](const int32 Y) {
 		for (int32 X = 0; X < Width; X++) {
 			FVector StartVector(
 				(X * Interval) + Min.X + (0.5f * Interval),
@@ -45,81 +146,196 @@ void UTileNavComponent::BuildNavigationTiles(const float GridScale, const float
 	            (Y * Interval) + Min.Y + (0.5f * Interval),
 	            (MinDepth)
 			);
-			StartVector = UKismetMathLibrary::Quat_RotateVector(CollisionTraceNormal.Quaternion(), StartVector);
-			EndVector = UKismetMathLibrary::Quat_RotateVector(CollisionTraceNormal.Quaternion(), EndVector);
+			StartVector = UKismetMathLibrary::Quat_RotateVector(TraceRotation, StartVector);
+			EndVector = UKismetMathLibrary::Quat_RotateVector(TraceRotation, EndVector);
 			FCollisionQueryParams QueryParams;
 			FHitResult OutHit;
 			bool bSurfaceExists = LineTraceComponent(
                 OutHit,
-                UKismetMathLibrary::TransformLocation(GetComponentTransform(), StartVector),
-                UKismetMathLibrary::TransformLocation(GetComponentTransform(), EndVector),
+                UKismetMathLibrary::TransformLocation(ComponentTransform, StartVector),
+                UKismetMathLibrary::TransformLocation(ComponentTransform, EndVector),
                 QueryParams
             );
 			FVector Location = bSurfaceExists ? OutHit.ImpactPoint : FVector();
-			TraceVertices.Add(FTileTraceVertex(Location, bSurfaceExists));
-			if (X > 0 && Y > 0) {
-				if (TraceVertices[Y * Width + X - 1].bCollision &&
-                    TraceVertices[(Y-1) * Width + X - 1].bCollision &&
-                    TraceVertices[(Y-1) * Width + X].bCollision &&
-                    TraceVertices[Y * Width + X].bCollision
-                ) {
-					
-					TArray<FVector> VectorArray;
-					VectorArray.Add(TraceVertices[Y * Width + X - 1].WorldLocation);
-					VectorArray.Add(TraceVertices[(Y-1) * Width + X - 1].WorldLocation);
-					VectorArray.Add(TraceVertices[(Y-1) * Width + X].WorldLocation);
-					VectorArray.Add(TraceVertices[Y * Width + X].WorldLocation);
-					FVector TileLocation = UKismetMathLibrary::GetVectorArrayAverage(VectorArray);
-
-					// Perform a sphere overlap of the surface point based on the default agent radius
-					TArray<UPrimitiveComponent*> OutComponents;				
-					UKismetSystemLibrary::SphereOverlapComponents(
-                        GetWorld(),
-                        TileLocation,
-                        FNavigationSystem::GetDefaultSupportedAgent().AgentRadius + Clearance,
-                        {ObjectTypeQuery1, ObjectTypeQuery2},
-                        UPrimitiveComponent::StaticClass(),
-                        {},
-                        OutComponents
-                    );
-
-					// Add a walkable tile if the overlapped objects ONLY contains TileNav and ignored components 
-					if (!OutComponents.ContainsByPredicate([this](UPrimitiveComponent* Component) {
-                        return !Cast<UTileNavComponent>(Component) && !IgnoreComponents.Contains(Component);
-                    })) {
-						WalkableTiles.Add(FIntPoint(X-1, Y-1), TileLocation);
-						
-						// If this tile is on the edge then store its index for the edge tiles list
-						if (X == 1 || Y == 1 || X == Width-1 || Y == Height-1 ) {
-							EdgeTileIndices.Add(WalkableTiles.Num() - 1);
-						}
-                    }
-                }
+			TraceVertices[Y * Width + X] = FTileTraceVertex(Location, bSurfaceExists);
+		}
+	}, !bParallel);
+	BuildStats.TraceMilliseconds += (FPlatformTime::Seconds() - PhaseStartTime) * 1000.0;
+
+	// Surface phase. Each tile whose four vertices all hit the surface sits at their average, writing only its own
+	// grid slot
+	PhaseStartTime = FPlatformTime::Seconds();
+	TArray<bool> SurfaceTiles;
+	SurfaceTiles.SetNumZeroed(BuildGrid.Num());
+	TArray<FVector>& Locations = BuildGrid.Locations.Edit();
+	ParallelFor(BuildGrid.Height, [&](const int32 TileY) {
+		const int32 Y = TileY + 1;
+		for (int32 X = 1; X < Width; X++) {
+			if (TraceVertices[Y * Width + X - 1].bCollision &&
+                TraceVertices[(Y-1) * Width + X - 1].bCollision &&
+                TraceVertices[(Y-1) * Width + X].bCollision &&
+                TraceVertices[Y * Width + X].bCollision
+            ) {
+				
+				TArray<FVector> VectorArray;
+				VectorArray.Add(TraceVertices[Y * Width + X - 1].WorldLocation);
+				VectorArray.Add(TraceVertices[(Y-1) * Width + X - 1].WorldLocation);
+				VectorArray.Add(TraceVertices[(Y-1) * Width + X].WorldLocation);
+				VectorArray.Add(TraceVertices[Y * Width + X].WorldLocation);
+				const int32 TileIndex = BuildGrid.GetIndex(X-1, TileY);
+				Locations[TileIndex] = UKismetMathLibrary::GetVectorArrayAverage(VectorArray);
+				SurfaceTiles[TileIndex] = true;
+            }
+		}
+	}, !bParallel);
+
+	// Clearance phase. Obstacles are rasterized into an occupancy grid padded by the clearance radius, and a distance
+	// transform gives every tile its distance to the nearest occupied cell. Walkable tiles keep their clearance, so
+	// that searches for larger agents can avoid the tiles too close to obstacles for them
+	TArray<float> Clearances;
+	BuildTileClearances(SurfaceTiles, MaxClearance, bParallel, Clearances);
+	ParallelFor(BuildGrid.Num(), [&](const int32 TileIndex) {
+		if (SurfaceTiles[TileIndex] && Clearances[TileIndex] >= WalkableClearance) {
+			BuildGrid.Flags[TileIndex] = ETileNavTileFlags::Valid | ETileNavTileFlags::Walkable;
+			BuildGrid.SetClearance(TileIndex, Clearances[TileIndex]);
+		} else {
+			Locations[TileIndex] = FVector::ZeroVector;
+		}
+	}, !bParallel);
+	BuildStats.ClearanceMilliseconds += (FPlatformTime::Seconds() - PhaseStartTime) * 1000.0;
+
+	// Merge phase. Runs serially in row-major order so tile counts and edge tile order match a serial build
+	PhaseStartTime = FPlatformTime::Seconds();
+	for (int32 TileY = 0; TileY < BuildGrid.Height; TileY++) {
+		for (int32 TileX = 0; TileX < BuildGrid.Width; TileX++) {
+			const int32 TileIndex = BuildGrid.GetIndex(TileX, TileY);
+			if (!BuildGrid.IsValidTile(TileIndex)) {
+				continue;
+			}
+			BuildGrid.NumTiles++;
+
+			// If this tile is on the edge then add it to the edge tiles list
+			if (TileX == 0 || TileY == 0 || TileX == BuildGrid.Width - 1 || TileY == BuildGrid.Height - 1) {
+				BuildGrid.EdgeTiles.Edit().Add(TileIndex, FEdgeNeighbors());
 			}
 		}
 	}
 
-	// Create an adjacency list for each walkable tile, used by pathfinding for neighbor searches
-	TArray<FIntPoint> WalkableTileKeys;
-	WalkableTiles.GenerateKeyArray(WalkableTileKeys);
-	TArray<FVector> WalkableTileValues;
-	WalkableTiles.GenerateValueArray(WalkableTileValues);
-	TArray<int32> WalkableNeighbors;
-	for (int32 Index = 0; Index < WalkableTileKeys.Num(); Index++) {
-		WalkableNeighbors.Empty();
-		FIntPoint Key = WalkableTileKeys[Index];
-		for (int32 Ny = -1; Ny <= 1; Ny++) {
-			for (int32 Nx = -1; Nx <= 1; Nx++) {
-				if (Nx == 0 && Ny == 0) continue;
-				if (WalkableTiles.Contains(FIntPoint(Key.X + Nx, Key.Y + Ny))) {
-					WalkableNeighbors.Add(WalkableTileKeys.Find(FIntPoint(Key.X + Nx, Key.Y + Ny)));
+	// Neighbor masks replace per-tile adjacency lists and are used by pathfinding for neighbor searches
+	BuildGrid.BuildNeighborMasks();
+	BuildGrid.UpdateTileBounds();
+	BuildGrid.BuildRegions();
+	BuildStats.MergeMilliseconds += (FPlatformTime::Seconds() - PhaseStartTime) * 1000.0;
+}
+
+void UTileNavComponent::BuildTileClearances(const TArray<bool>& SurfaceTiles, const float ClearanceRadius, const bool bParallel, TArray<float>& OutClearances) {
+	FTileNavGrid& BuildGrid = *Grid;
+	OutClearances.Init(MAX_FLT, BuildGrid.Num());
+	UWorld* World = GetWorld();
+	const FVector Scale = BuildGrid.ComponentTransform.GetScale3D().GetAbs();
+	const float TileSpacing = BuildGrid.Interval * Scale.GetMin();
+	if (!World || BuildGrid.Num() == 0 || TileSpacing <= 0.0f) {
+		return;
+	}
+
+	// Cells beyond the surface sit on its mean depth, so that obstacles just off the edge of the mesh still count
+	float MeanDepth = 0.0f;
+	int32 NumSurfaceTiles = 0;
+	for (int32 TileIndex = 0; TileIndex < BuildGrid.Num(); TileIndex++) {
+		if (SurfaceTiles[TileIndex]) {
+			MeanDepth += BuildGrid.GetDepth(BuildGrid.Locations[TileIndex]);
+			NumSurfaceTiles++;
+		}
+	}
+	if (NumSurfaceTiles == 0) {
+		return;
+	}
+	MeanDepth /= NumSurfaceTiles;
+	const int32 Padding = FMath::CeilToInt(ClearanceRadius / TileSpacing) + 1;
+	const int32 CellsX = BuildGrid.Width + 2 * Padding;
+	const int32 CellsY = BuildGrid.Height + 2 * Padding;
+	const auto GetCellLocation = [&](const int32 CellX, const int32 CellY) {
+		const int32 TileX = CellX - Padding;
+		const int32 TileY = CellY - Padding;
+		if (BuildGrid.IsInBounds(TileX, TileY) && SurfaceTiles[BuildGrid.GetIndex(TileX, TileY)]) {
+			return BuildGrid.Locations[BuildGrid.GetIndex(TileX, TileY)];
+		}
+		return BuildGrid.GridToWorld(TileX, TileY, MeanDepth);
+	};
+
+	// A single overlap over the padded grid finds every obstacle that could come within the clearance radius
+	FCollisionObjectQueryParams ObjectQueryParams;
+	ObjectQueryParams.AddObjectTypesToQuery(ECC_WorldStatic);
+	ObjectQueryParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+	const FBox QueryBounds = Bounds.GetBox().ExpandBy(ClearanceRadius + TileSpacing * 2.0f);
+	TArray<FOverlapResult> Overlaps;
+	World->OverlapMultiByObjectType(Overlaps, QueryBounds.GetCenter(), FQuat::Identity, ObjectQueryParams, FCollisionShape::MakeBox(QueryBounds.GetExtent()));
+
+	// Each obstacle covers the cells under its bounds, clamped to the padded grid
+	TArray<UPrimitiveComponent*> Obstacles;
+	TArray<FIntRect> Footprints;
+	for (auto& Overlap: Overlaps) {
+		UPrimitiveComponent* Component = Overlap.GetComponent();
+		if (!Component || Cast<UTileNavComponent>(Component) || IgnoreComponents.Contains(Component) || Obstacles.Contains(Component)) {
+			continue;
+		}
+		const FBox ObstacleBounds = Component->Bounds.GetBox();
+		FVector2D FootprintMin(MAX_FLT, MAX_FLT);
+		FVector2D FootprintMax(-MAX_FLT, -MAX_FLT);
+		for (int32 Corner = 0; Corner < 8; Corner++) {
+			const FVector CornerLocation(
+				Corner & 1 ? ObstacleBounds.Max.X : ObstacleBounds.Min.X,
+				Corner & 2 ? ObstacleBounds.Max.Y : ObstacleBounds.Min.Y,
+				Corner & 4 ? ObstacleBounds.Max.Z : ObstacleBounds.Min.Z
+			);
+			const FVector2D GridCorner = BuildGrid.WorldToGrid(CornerLocation);
+			FootprintMin = FVector2D::Min(FootprintMin, GridCorner);
+			FootprintMax = FVector2D::Max(FootprintMax, GridCorner);
+		}
+		const FIntRect Footprint(
+			FMath::Max(FMath::FloorToInt(FootprintMin.X) + Padding, 0),
+			FMath::Max(FMath::FloorToInt(FootprintMin.Y) + Padding, 0),
+			FMath::Min(FMath::CeilToInt(FootprintMax.X) + Padding, CellsX - 1),
+			FMath::Min(FMath::CeilToInt(FootprintMax.Y) + Padding, CellsY - 1)
+		);
+		if (Footprint.Min.X <= Footprint.Max.X && Footprint.Min.Y <= Footprint.Max.Y) {
+			Obstacles.Add(Component);
+			Footprints.Add(Footprint);
+		}
+	}
+
+	// Rasterize by row. A cell is occupied when an obstacle overlaps its column, a box the size of the cell reaching
+	// the clearance radius above and below the surface. Occupied cells start the distance transform at zero
+	const FQuat CellRotation = BuildGrid.ComponentTransform.GetRotation() * BuildGrid.TraceRotation;
+	const FCollisionShape CellShape = FCollisionShape::MakeBox(FVector(
+		0.5f * BuildGrid.Interval * Scale.X,
+		0.5f * BuildGrid.Interval * Scale.Y,
+		ClearanceRadius
+	));
+	const float Unoccupied = FMath::Square(static_cast<float>(CellsX + CellsY));
+	TArray<float> SquaredDistances;
+	SquaredDistances.Init(Unoccupied, CellsX * CellsY);
+	ParallelFor(CellsY, [&](const int32 CellY) {
+		for (int32 Obstacle = 0; Obstacle < Obstacles.Num(); Obstacle++) {
+			const FIntRect& Footprint = Footprints[Obstacle];
+			if (CellY < Footprint.Min.Y || CellY > Footprint.Max.Y) {
+				continue;
+			}
+			for (int32 CellX = Footprint.Min.X; CellX <= Footprint.Max.X; CellX++) {
+				float& SquaredDistance = SquaredDistances[CellY * CellsX + CellX];
+				if (SquaredDistance != 0.0f && Obstacles[Obstacle]->OverlapComponent(GetCellLocation(CellX, CellY), CellRotation, CellShape)) {
+					SquaredDistance = 0.0f;
 				}
 			}
 		}
-	
-		Tiles.Add(WalkableTileValues[Index], FTileNavTile(true, WalkableNeighbors));
-		if (EdgeTileIndices.Contains(Index)) {
-			EdgeTiles.Add(WalkableTileValues[Index], FEdgeNeighbors());
+	}, !bParallel);
+	FTileNavGrid::ComputeDistanceTransform(SquaredDistances, CellsX, CellsY, bParallel);
+
+	// Measured to the corner of the nearest occupied cell, so clearances never overestimate
+	for (int32 TileY = 0; TileY < BuildGrid.Height; TileY++) {
+		for (int32 TileX = 0; TileX < BuildGrid.Width; TileX++) {
+			const float CellDistance = FMath::Sqrt(SquaredDistances[(TileY + Padding) * CellsX + TileX + Padding]);
+			OutClearances[BuildGrid.GetIndex(TileX, TileY)] = FMath::Max(CellDistance - HALF_SQRT_2, 0.0f) * TileSpacing;
 		}
 	}
 }
@@ -131,15 +347,44 @@ void UTileNavComponent::GetCollisionBounds(FBox &CollisionBounds) const {
 }
 
 bool UTileNavComponent::UpdateTiles(TArray<FVector> InTiles, const bool bWalkable) {
+
+	// Queries may still be reading the current grid through a published snapshot, so changes are made to a copy. The
+	// copy shares the locations, masks, clearances and edge tiles that updates leave alone, so only the flags and the
+	// data derived from them are duplicated
+	TSharedRef<FTileNavGrid, ESPMode::ThreadSafe> UpdatedGrid = MakeShared<FTileNavGrid, ESPMode::ThreadSafe>(*Grid);
+	bool bUpdated = true;
+	TArray<int32> ChangedTiles;
 	for (auto& Tile : InTiles) {
-		if (Tiles.Contains(Tile)) {
-			const TArray<int32> Neighbours = Tiles[Tile].Neighbors;
-			Tiles.Add(Tile, FTileNavTile(bWalkable, Neighbours));
-		} else {
-			return false;
+		const int32 TileIndex = UpdatedGrid->GetTileIndex(Tile);
+		const bool bChanged = UpdatedGrid->IsValidTile(TileIndex) && UpdatedGrid->IsWalkable(TileIndex) != bWalkable;
+		if (!UpdatedGrid->SetWalkable(TileIndex, bWalkable)) {
+			bUpdated = false;
+			break;
 		}
+		if (bChanged) {
+			ChangedTiles.Add(TileIndex);
+		}
+	}
+
+	// Blocked tiles change the walkable distances between portals
+	UpdatedGrid->BuildPortals();
+
+	// Blocking only lengthens walkable distances, so landmark bounds stay admissible, but unblocking can shorten them
+	if (bWalkable && ChangedTiles.Num() > 0 && UpdatedGrid->Landmarks.Num() > 0) {
+		UpdatedGrid->BuildLandmarks(UpdatedGrid->Landmarks.Num());
+	}
+
+	// Only the clusters around the changed tiles have their entrances and distances rebuilt
+	UpdatedGrid->Clusters.Update(*UpdatedGrid, ChangedTiles);
+	Grid = UpdatedGrid;
+	if (NavigationData.IsValid()) {
+		NavigationData->UpdateSectionRoutes();
+		NavigationData->PublishSnapshot();
+
+		// Paths through this section are repaired against the snapshot just published
+		NavigationData->RepairActivePaths(SectionIndex, ChangedTiles);
 	}
-	return true;
+	return bUpdated;
 }
 
 bool UTileNavComponent::UpdateTile(const FVector Tile, const bool bWalkable) {
@@ -147,65 +392,17 @@ bool UTileNavComponent::UpdateTile(const FVector Tile, const bool bWalkable) {
 }
 
 void UTileNavComponent::FindPath(const FVector Start, const FVector End, bool &bFound, TArray<FVector> &PathTiles) {
-	if (!Tiles.Contains(Start) || !Tiles.Contains(End) || Start == End) return;
-	
-	// Hard limit for the number of tiles to search. Prevents an infinite loop.
-	int32 Limit = 5000; 
-	TArray<FVector> NavKeys;
-	Tiles.GenerateKeyArray(NavKeys);
-	TArray<FPathTile> OpenList;
-	TArray<FPathTile> ClosedList;
-	const int32 PathIndex = PathTiles.Num();
-	OpenList.Add(FPathTile(NavKeys.IndexOfByKey(Start)));
-
-	do {
-		Limit--;	
-		FPathTile CurrentPathTile = OpenList[0];
-		int32 CurrentPathTileIndex = 0;
-		for (int Index = 0; Index < OpenList.Num(); Index++) {
-			if (OpenList[Index].F < CurrentPathTile.F) {
-				CurrentPathTileIndex = Index;
-				CurrentPathTile = OpenList[Index];
-			}
-		}
-		
-		OpenList.RemoveAtSwap(CurrentPathTileIndex);
-		ClosedList.Add(CurrentPathTile);
-		if (NavKeys[CurrentPathTile.Index] == End) {
-			bFound = true;
-			do {
-				const FPathTile NextTile = *ClosedList.FindByPredicate([CurrentPathTile](const FPathTile Tile) {
-                    return Tile.Index == CurrentPathTile.Parent;
-                });
-				PathTiles.Insert(NavKeys[NextTile.Index], PathIndex);
-				CurrentPathTile = NextTile;
-			} while (CurrentPathTile.Parent != -1);
-			PathTiles.Add(End);
-			return;
-		}
-
-		for (auto& ChildIndex: Tiles[NavKeys[CurrentPathTile.Index]].Neighbors) {
-			if (ClosedList.ContainsByPredicate([ChildIndex](const FPathTile Tile) {
-                return Tile.Index == ChildIndex;
-            }) || !Tiles[NavKeys[ChildIndex]].bWalkable) {
-				continue;
-            }
+	FTileNavSearchStats Stats;
+	FindPathWithStats(Start, End, ETileNavSearchMode::AStar, bFound, PathTiles, Stats);
+}
 
-			FPathTile ChildTile(ChildIndex);
-			ChildTile.G = CurrentPathTile.G + FVector::Distance(NavKeys[ChildIndex], NavKeys[CurrentPathTile.Index]);
-			ChildTile.H = FVector::Distance(NavKeys[ChildIndex], End);
-			ChildTile.F = ChildTile.G + ChildTile.H;
-			ChildTile.Parent = CurrentPathTile.Index;
-
-			if (OpenList.ContainsByPredicate([ChildTile](const FPathTile Tile) {
-                return Tile.Index == ChildTile.Index;
-            })) {
-				if (ChildTile.G > CurrentPathTile.G) {
-					continue;
-				}
-            }
+void UTileNavComponent::FindPathWithStats(
+	const FVector Start,
+	const FVector End,
+	const ETileNavSearchMode SearchMode,
+	bool &bFound,
+	TArray<FVector> &PathTiles,
+	FTileNavSearchStats& Stats) const {
 
-			OpenList.Add(ChildTile);
-		}
-	} while (OpenList.Num() > 0 && Limit > 0);
+	Grid->FindPath(Start, End, SearchMode, bFound, PathTiles, Stats);
 }
\ No newline at end of file
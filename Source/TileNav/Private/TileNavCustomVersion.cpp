@@ -0,0 +1,6 @@
+#include "TileNavCustomVersion.h"
+#include "Serialization/CustomVersion.h"
+
+const FGuid FTileNavCustomVersion::GUID(0x7A3C5E21, 0x94D04B6F, 0xA1E8C2D7, 0x3F6B9058);
+
+FCustomVersionRegistration GRegisterTileNavCustomVersion(FTileNavCustomVersion::GUID, FTileNavCustomVersion::LatestVersion, TEXT("TileNavVer"));
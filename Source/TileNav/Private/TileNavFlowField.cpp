@@ -0,0 +1,231 @@
+#include "TileNavFlowField.h"
+
+namespace TileNavFlow {
+	template <typename OpenTileType>
+	struct TNearest {
+		FORCEINLINE bool operator()(const OpenTileType& A, const OpenTileType& B) const {
+			return A.Distance < B.Distance;
+		}
+	};
+}
+
+FTileNavFlowField::FTileNavFlowField(): GoalSection(INDEX_NONE), GoalTile(INDEX_NONE), MaxLinkDistance(0.0f) {
+}
+
+void FTileNavFlowField::Build(const FTileNavSnapshotPtr& InSnapshot, const int32 InGoalSection, const int32 InGoalTile, const float InMaxLinkDistance) {
+	Snapshot = InSnapshot;
+	GoalSection = InGoalSection;
+	GoalTile = InGoalTile;
+	MaxLinkDistance = InMaxLinkDistance;
+	Stats = FTileNavSearchStats();
+	Fields.Reset();
+	Links.Reset();
+	if (!Snapshot.IsValid() || !Snapshot->GetGrid(GoalSection)) {
+		return;
+	}
+	const double StartTime = FPlatformTime::Seconds();
+	Fields.SetNum(Snapshot->Grids.Num());
+	BuildLinks();
+
+	TArray<FOpenTile> Open;
+	Relax(Open, GoalSection, GoalTile, 0.0f, GoalDirection);
+	Integrate(Open);
+	Stats.Milliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+}
+
+void FTileNavFlowField::MoveGoal(const int32 NewGoalSection, const int32 NewGoalTile) {
+	if (NewGoalSection == GoalSection && NewGoalTile == GoalTile) {
+		return;
+	}
+
+	// The moves are symmetric, so the old field already holds the distance between the two goals
+	const float GoalDistance = GetDistance(NewGoalSection, NewGoalTile);
+	if (GoalDistance == MAX_FLT) {
+		Build(Snapshot, NewGoalSection, NewGoalTile, MaxLinkDistance);
+		return;
+	}
+	const double StartTime = FPlatformTime::Seconds();
+	Stats = FTileNavSearchStats();
+
+	// Every path to the old goal can carry on to the new one, so the old distances plus the distance between the
+	// goals are upper bounds. Tiles left at their bound still lead to the old goal along a shortest path, so only the
+	// old goal itself is cleared, to point it on towards the new one
+	for (auto& Field: Fields) {
+		for (float& Distance: Field.Distances) {
+			if (Distance != MAX_FLT) {
+				Distance += GoalDistance;
+			}
+		}
+	}
+	FSectionField& OldGoalField = Fields[GoalSection];
+	OldGoalField.Distances[GoalTile] = MAX_FLT;
+	OldGoalField.Directions[GoalTile] = Unreached;
+	GoalSection = NewGoalSection;
+	GoalTile = NewGoalTile;
+
+	TArray<FOpenTile> Open;
+	Relax(Open, GoalSection, GoalTile, 0.0f, GoalDirection);
+	Integrate(Open);
+	Stats.Milliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+}
+
+bool FTileNavFlowField::IsCurrent(const FTileNavSnapshot& OtherSnapshot) const {
+	return Snapshot.IsValid() && Snapshot->SectionGenerations == OtherSnapshot.SectionGenerations;
+}
+
+bool FTileNavFlowField::GetNextTile(const int32 Section, const int32 Tile, int32& OutSection, int32& OutTile) const {
+	if (GetDistance(Section, Tile) == MAX_FLT) {
+		return false;
+	}
+	const FSectionField& Field = Fields[Section];
+	const uint8 Direction = Field.Directions[Tile];
+	if (Direction == LinkDirection) {
+		const FTileNavFlowLink& Exit = Field.Exits.FindChecked(Tile);
+		OutSection = Exit.Section;
+		OutTile = Exit.Tile;
+		return true;
+	}
+	if (Direction < GoalDirection) {
+		OutSection = Section;
+		OutTile = Tile + Snapshot->GetGrid(Section)->NeighborOffsets[Direction];
+		return true;
+	}
+	return false;
+}
+
+bool FTileNavFlowField::Sample(const FVector& Location, const float SearchRadius, int32& InOutSection, FVector& OutDirection, float& OutDistance) const {
+	if (!Snapshot.IsValid()) {
+		return false;
+	}
+	const FTileNavGrid* Grid = Snapshot->GetGrid(InOutSection);
+	int32 Tile = Grid ? Grid->GetTileIndex(Location) : INDEX_NONE;
+	if (Tile == INDEX_NONE || GetDistance(InOutSection, Tile) == MAX_FLT) {
+		if (!Snapshot->FindNearestTile(Location, SearchRadius, InOutSection, Tile)) {
+			return false;
+		}
+	}
+	OutDistance = GetDistance(InOutSection, Tile);
+	if (OutDistance == MAX_FLT) {
+		return false;
+	}
+	int32 NextSection, NextTile;
+	if (GetNextTile(InOutSection, Tile, NextSection, NextTile)) {
+		OutDirection = (Snapshot->GetGrid(NextSection)->Locations[NextTile] - Location).GetSafeNormal();
+	} else {
+		OutDirection = FVector::ZeroVector;
+	}
+	return true;
+}
+
+SIZE_T FTileNavFlowField::GetAllocatedSize() const {
+	SIZE_T Size = Fields.GetAllocatedSize() + Links.GetAllocatedSize();
+	for (auto& Field: Fields) {
+		Size += Field.Distances.GetAllocatedSize() + Field.Directions.GetAllocatedSize() + Field.Exits.GetAllocatedSize();
+	}
+	for (auto& SectionLinks: Links) {
+		Size += SectionLinks.GetAllocatedSize();
+		for (auto& TileLinks: SectionLinks) {
+			Size += TileLinks.Value.GetAllocatedSize();
+		}
+	}
+	return Size;
+}
+
+void FTileNavFlowField::BuildLinks() {
+	Links.SetNum(Snapshot->Grids.Num());
+	for (int32 Section = 0; Section < Snapshot->Grids.Num(); Section++) {
+		const FTileNavGrid* Grid = Snapshot->GetGrid(Section);
+		if (!Grid) {
+			continue;
+		}
+		for (auto& EdgeTile: Grid->EdgeTiles) {
+			if (!Grid->IsWalkable(EdgeTile.Key)) {
+				continue;
+			}
+			const FVector& Location = Grid->Locations[EdgeTile.Key];
+			for (const int32 OtherSection: EdgeTile.Value.NavSections) {
+				const FTileNavGrid* OtherGrid = Snapshot->GetGrid(OtherSection);
+				const int32 OtherTile = OtherGrid ? OtherGrid->FindNearestWalkableTile(Location) : INDEX_NONE;
+				if (OtherTile == INDEX_NONE) {
+					continue;
+				}
+				const float Cost = FVector::Distance(Location, OtherGrid->Locations[OtherTile]);
+				if (Cost <= MaxLinkDistance) {
+					Links[Section].FindOrAdd(EdgeTile.Key).Add(FTileNavFlowLink(OtherSection, OtherTile, Cost));
+					Links[OtherSection].FindOrAdd(OtherTile).Add(FTileNavFlowLink(Section, EdgeTile.Key, Cost));
+				}
+			}
+		}
+	}
+}
+
+FTileNavFlowField::FSectionField& FTileNavFlowField::GetField(const int32 Section) {
+
+	// Sections are only allocated once the field reaches them
+	FSectionField& Field = Fields[Section];
+	if (Field.Distances.Num() == 0) {
+		const int32 NumTiles = Snapshot->GetGrid(Section)->Num();
+		Field.Distances.Init(MAX_FLT, NumTiles);
+		Field.Directions.Init(Unreached, NumTiles);
+	}
+	return Field;
+}
+
+bool FTileNavFlowField::Relax(
+	TArray<FOpenTile>& Open,
+	const int32 Section,
+	const int32 Tile,
+	const float Distance,
+	const uint8 Direction,
+	const FTileNavFlowLink* Exit) {
+
+	FSectionField& Field = GetField(Section);
+	if (Distance >= Field.Distances[Tile]) {
+		return false;
+	}
+	if (Field.Directions[Tile] == LinkDirection) {
+		Field.Exits.Remove(Tile);
+	}
+	Field.Distances[Tile] = Distance;
+	Field.Directions[Tile] = Direction;
+	if (Exit) {
+		Field.Exits.Add(Tile, *Exit);
+	}
+	Open.HeapPush(FOpenTile{Section, Tile, Distance}, TileNavFlow::TNearest<FOpenTile>());
+	return true;
+}
+
+void FTileNavFlowField::Integrate(TArray<FOpenTile>& Open) {
+
+	// Dijkstra outward from the goal, pointing each tile back at the tile it was reached from. Tiles are only ever
+	// lowered, so the same loop serves a full build and a goal move
+	while (Open.Num() > 0) {
+		FOpenTile Current;
+		Open.HeapPop(Current, TileNavFlow::TNearest<FOpenTile>(), false);
+		if (Current.Distance > Fields[Current.Section].Distances[Current.Tile]) {
+			continue;
+		}
+		Stats.Expansions++;
+
+		const FTileNavGrid& Grid = *Snapshot->GetGrid(Current.Section);
+		const FVector& CurrentLocation = Grid.Locations[Current.Tile];
+		const uint8 Mask = Grid.NeighborMasks[Current.Tile];
+		for (int32 Direction = 0; Direction < 8; Direction++) {
+			if (!(Mask & (1 << Direction))) {
+				continue;
+			}
+			const int32 NeighborTile = Current.Tile + Grid.NeighborOffsets[Direction];
+			if (Grid.IsWalkable(NeighborTile)) {
+				Relax(Open, Current.Section, NeighborTile, Current.Distance + FVector::Distance(Grid.Locations[NeighborTile], CurrentLocation), (Direction + 4) % 8);
+			}
+		}
+
+		const TArray<FTileNavFlowLink>* TileLinks = Links[Current.Section].Find(Current.Tile);
+		if (TileLinks) {
+			for (auto& Link: *TileLinks) {
+				const FTileNavFlowLink Exit(Current.Section, Current.Tile, Link.Cost);
+				Relax(Open, Link.Section, Link.Tile, Current.Distance + Link.Cost, LinkDirection, &Exit);
+			}
+		}
+	}
+}
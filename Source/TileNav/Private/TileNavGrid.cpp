@@ -0,0 +1,1190 @@
+#include "TileNavGrid.h"
+#include "TileNavCustomVersion.h"
+#include "TileNavSearchState.h"
+#include "Async/ParallelFor.h"
+
+const FIntPoint FTileNavGrid::DirectionOffsets[8] = {
+	FIntPoint(1, 0),
+	FIntPoint(1, 1),
+	FIntPoint(0, 1),
+	FIntPoint(-1, 1),
+	FIntPoint(-1, 0),
+	FIntPoint(-1, -1),
+	FIntPoint(0, -1),
+	FIntPoint(1, -1)
+};
+
+FTileNavGrid::FTileNavGrid(): Width(0), Height(0), NumTiles(0), Origin(FVector2D::ZeroVector), Interval(1.0f), ClearanceStep(1.0f), WalkableClearance(MAX_FLT), TileBounds(ForceInit), LandmarkStep(1.0f), BidirectionalDistance(MAX_FLT), CenterTile(INDEX_NONE) {
+	ComponentTransform = FTransform::Identity;
+	TraceRotation = FQuat::Identity;
+	FMemory::Memzero(NeighborOffsets);
+}
+
+void FTileNavGrid::Init(
+	const int32 InWidth,
+	const int32 InHeight,
+	const FTransform& InComponentTransform,
+	const FQuat& InTraceRotation,
+	const FVector2D& InOrigin,
+	const float InInterval) {
+
+	Reset();
+	Width = FMath::Max(InWidth, 0);
+	Height = FMath::Max(InHeight, 0);
+	ComponentTransform = InComponentTransform;
+	TraceRotation = InTraceRotation;
+	Origin = InOrigin;
+	Interval = InInterval;
+	UpdateNeighborOffsets();
+	Locations.Edit().SetNumZeroed(Num());
+	Flags.SetNumZeroed(Num());
+	NeighborMasks.Edit().SetNumZeroed(Num());
+	Clearances.Edit().SetNumZeroed(Num());
+}
+
+void FTileNavGrid::Reset() {
+	Width = 0;
+	Height = 0;
+	NumTiles = 0;
+	Locations.Empty();
+	Flags.Empty();
+	NeighborMasks.Empty();
+	Clearances.Empty();
+	ClearanceStep = 1.0f;
+	WalkableClearance = MAX_FLT;
+	EdgeTiles.Empty();
+	TileBounds.Init();
+	Portals.Empty();
+	PortalCosts.Empty();
+	CenterTile = INDEX_NONE;
+	CenterPortalCosts.Empty();
+	Regions.Empty();
+	RegionSizes.Empty();
+	Landmarks.Empty();
+	LandmarkDistances.Empty();
+	LandmarkStep = 1.0f;
+	Clusters.Reset();
+}
+
+void FTileNavGrid::BuildNeighborMasks() {
+	TArray<uint8>& Masks = NeighborMasks.Edit();
+	for (int32 Y = 0; Y < Height; Y++) {
+		for (int32 X = 0; X < Width; X++) {
+			const int32 Index = GetIndex(X, Y);
+			uint8 Mask = 0;
+			if (Flags[Index] & ETileNavTileFlags::Valid) {
+				for (int32 Direction = 0; Direction < 8; Direction++) {
+					const int32 Nx = X + DirectionOffsets[Direction].X;
+					const int32 Ny = Y + DirectionOffsets[Direction].Y;
+					if (IsInBounds(Nx, Ny) && (Flags[GetIndex(Nx, Ny)] & ETileNavTileFlags::Valid)) {
+						Mask |= 1 << Direction;
+					}
+				}
+			}
+			Masks[Index] = Mask;
+		}
+	}
+}
+
+void FTileNavGrid::UpdateTileBounds() {
+	TileBounds.Init();
+	for (int32 Index = 0; Index < Num(); Index++) {
+		if (IsValidTile(Index)) {
+			TileBounds += Locations[Index];
+		}
+	}
+}
+
+FVector2D FTileNavGrid::WorldToGrid(const FVector& Location) const {
+	const FVector Local = TraceRotation.UnrotateVector(ComponentTransform.InverseTransformPosition(Location));
+	return FVector2D((Local.X - Origin.X) / Interval, (Local.Y - Origin.Y) / Interval);
+}
+
+FVector FTileNavGrid::GridToWorld(const float X, const float Y, const float Depth) const {
+	return ComponentTransform.TransformPosition(TraceRotation.RotateVector(FVector(Origin.X + X * Interval, Origin.Y + Y * Interval, Depth)));
+}
+
+float FTileNavGrid::GetDepth(const FVector& Location) const {
+	return TraceRotation.UnrotateVector(ComponentTransform.InverseTransformPosition(Location)).Z;
+}
+
+void FTileNavGrid::ComputeDistanceTransform(TArray<float>& SquaredDistances, const int32 InWidth, const int32 InHeight, const bool bParallel) {
+
+	// One dimensional transform of Felzenszwalb and Huttenlocher, taking the lower envelope of the parabolas rooted at
+	// each cell. Linear in the number of cells
+	const auto Transform1D = [](const float* Source, float* Target, const int32 Count, int32* Vertices, float* Boundaries) {
+		int32 Envelope = 0;
+		Vertices[0] = 0;
+		Boundaries[0] = -MAX_FLT;
+		Boundaries[1] = MAX_FLT;
+		const auto Intersect = [Source](const int32 Q, const int32 V) {
+			return ((Source[Q] + Q * Q) - (Source[V] + V * V)) / (2 * Q - 2 * V);
+		};
+		for (int32 Q = 1; Q < Count; Q++) {
+			float S = Intersect(Q, Vertices[Envelope]);
+			while (S <= Boundaries[Envelope]) {
+				Envelope--;
+				S = Intersect(Q, Vertices[Envelope]);
+			}
+			Envelope++;
+			Vertices[Envelope] = Q;
+			Boundaries[Envelope] = S;
+			Boundaries[Envelope + 1] = MAX_FLT;
+		}
+		Envelope = 0;
+		for (int32 Q = 0; Q < Count; Q++) {
+			while (Boundaries[Envelope + 1] < Q) {
+				Envelope++;
+			}
+			const int32 V = Vertices[Envelope];
+			Target[Q] = FMath::Square(Q - V) + Source[V];
+		}
+	};
+
+	const int32 MaxCount = FMath::Max(InWidth, InHeight);
+	ParallelFor(InWidth, [&](const int32 X) {
+		TArray<float> Column, Result, Boundaries;
+		TArray<int32> Vertices;
+		Column.SetNumUninitialized(InHeight);
+		Result.SetNumUninitialized(InHeight);
+		Vertices.SetNumUninitialized(MaxCount);
+		Boundaries.SetNumUninitialized(MaxCount + 1);
+		for (int32 Y = 0; Y < InHeight; Y++) {
+			Column[Y] = SquaredDistances[Y * InWidth + X];
+		}
+		Transform1D(Column.GetData(), Result.GetData(), InHeight, Vertices.GetData(), Boundaries.GetData());
+		for (int32 Y = 0; Y < InHeight; Y++) {
+			SquaredDistances[Y * InWidth + X] = Result[Y];
+		}
+	}, !bParallel);
+	ParallelFor(InHeight, [&](const int32 Y) {
+		TArray<float> Row, Boundaries;
+		TArray<int32> Vertices;
+		Row.SetNumUninitialized(InWidth);
+		Vertices.SetNumUninitialized(MaxCount);
+		Boundaries.SetNumUninitialized(MaxCount + 1);
+		FMemory::Memcpy(Row.GetData(), &SquaredDistances[Y * InWidth], InWidth * sizeof(float));
+		Transform1D(Row.GetData(), &SquaredDistances[Y * InWidth], InWidth, Vertices.GetData(), Boundaries.GetData());
+	}, !bParallel);
+}
+
+int32 FTileNavGrid::GetTileIndex(const FVector& Location) const {
+	if (Num() == 0) {
+		return INDEX_NONE;
+	}
+	const FVector2D GridLocation = WorldToGrid(Location);
+	const int32 X = FMath::RoundToInt(GridLocation.X);
+	const int32 Y = FMath::RoundToInt(GridLocation.Y);
+	if (!IsInBounds(X, Y)) {
+		return INDEX_NONE;
+	}
+	const int32 Index = GetIndex(X, Y);
+	return IsValidTile(Index) ? Index : INDEX_NONE;
+}
+
+uint8 FTileNavGrid::GetClearanceLevel(const float Radius) const {
+	if (Radius <= WalkableClearance) {
+		return 0;
+	}
+	return static_cast<uint8>(FMath::Clamp(FMath::CeilToInt(Radius / ClearanceStep), 1, static_cast<int32>(MAX_uint8)));
+}
+
+void FTileNavGrid::SetClearance(const int32 Index, const float Clearance) {
+	Clearances.Edit()[Index] = static_cast<uint8>(FMath::Clamp(FMath::FloorToInt(Clearance / ClearanceStep), 0, static_cast<int32>(MAX_uint8)));
+}
+
+int32 FTileNavGrid::FindNearestWalkableTile(const FVector& Location, const uint8 MinClearance) const {
+	if (Num() == 0) {
+		return INDEX_NONE;
+	}
+	const FVector2D GridLocation = WorldToGrid(Location);
+	const int32 CenterX = FMath::Clamp(FMath::RoundToInt(GridLocation.X), 0, Width - 1);
+	const int32 CenterY = FMath::Clamp(FMath::RoundToInt(GridLocation.Y), 0, Height - 1);
+	const int32 MaxRing = FMath::Max(FMath::Max(CenterX, Width - 1 - CenterX), FMath::Max(CenterY, Height - 1 - CenterY));
+
+	// Tile locations sit on their grid cell centers in the grid plane, so every tile in ring N is at least
+	// (N - CenterOffset) tile spacings from the location in world space
+	const float CenterOffset = FMath::Max(FMath::Abs(GridLocation.X - CenterX), FMath::Abs(GridLocation.Y - CenterY));
+	const float TileSpacing = Interval * ComponentTransform.GetScale3D().GetAbsMin();
+
+	int32 NearestIndex = INDEX_NONE;
+	float NearestDistance = MAX_FLT;
+	const auto VisitTile = [&](const int32 X, const int32 Y) {
+		const int32 Index = GetIndex(X, Y);
+		if (IsWalkable(Index, MinClearance)) {
+			const float Distance = FVector::DistSquared(Location, Locations[Index]);
+			if (Distance < NearestDistance) {
+				NearestDistance = Distance;
+				NearestIndex = Index;
+			}
+		}
+	};
+
+	VisitTile(CenterX, CenterY);
+	for (int32 Ring = 1; Ring <= MaxRing; Ring++) {
+		const float RingDistance = (Ring - CenterOffset) * TileSpacing;
+		if (NearestIndex != INDEX_NONE && RingDistance > 0.0f && FMath::Square(RingDistance) > NearestDistance) {
+			break;
+		}
+
+		// Top and bottom rows of the ring, then its left and right columns, clipped to the grid
+		const int32 MinX = FMath::Max(CenterX - Ring, 0);
+		const int32 MaxX = FMath::Min(CenterX + Ring, Width - 1);
+		for (const int32 Y: {CenterY - Ring, CenterY + Ring}) {
+			if (Y >= 0 && Y < Height) {
+				for (int32 X = MinX; X <= MaxX; X++) {
+					VisitTile(X, Y);
+				}
+			}
+		}
+		const int32 MinY = FMath::Max(CenterY - Ring + 1, 0);
+		const int32 MaxY = FMath::Min(CenterY + Ring - 1, Height - 1);
+		for (const int32 X: {CenterX - Ring, CenterX + Ring}) {
+			if (X >= 0 && X < Width) {
+				for (int32 Y = MinY; Y <= MaxY; Y++) {
+					VisitTile(X, Y);
+				}
+			}
+		}
+	}
+	return NearestIndex;
+}
+
+int32 FTileNavGrid::FindNearestWalkableTileLinear(const FVector& Location) const {
+	int32 NearestIndex = INDEX_NONE;
+	float NearestDistance = MAX_FLT;
+	for (int32 Index = 0; Index < Num(); Index++) {
+		if (IsWalkable(Index)) {
+			const float Distance = FVector::DistSquared(Location, Locations[Index]);
+			if (Distance < NearestDistance) {
+				NearestDistance = Distance;
+				NearestIndex = Index;
+			}
+		}
+	}
+	return NearestIndex;
+}
+
+bool FTileNavGrid::SetWalkable(const int32 Index, const bool bWalkable) {
+	if (!IsValidTile(Index)) {
+		return false;
+	}
+	const bool bWasWalkable = IsWalkable(Index);
+	if (bWalkable) {
+		Flags[Index] |= ETileNavTileFlags::Walkable;
+	} else {
+		Flags[Index] &= ~ETileNavTileFlags::Walkable;
+	}
+	if (bWalkable == bWasWalkable || Regions.Num() != Num()) {
+		return true;
+	}
+
+	// Retired labels pile up as regions merge and split, so they are compacted once they outnumber the tiles
+	if (RegionSizes.Num() > 2 * NumTiles) {
+		BuildRegions();
+	} else if (bWalkable) {
+		JoinRegions(Index);
+	} else {
+		SplitRegion(Index);
+	}
+	return true;
+}
+
+void FTileNavGrid::BuildRegions() {
+	Regions.Init(INDEX_NONE, Num());
+	RegionSizes.Reset();
+	for (int32 Index = 0; Index < Num(); Index++) {
+		if (Regions[Index] == INDEX_NONE && IsWalkable(Index)) {
+			const int32 Region = RegionSizes.Add(0);
+			RegionSizes[Region] = FloodRegion(Index, INDEX_NONE, Region);
+		}
+	}
+}
+
+bool FTileNavGrid::CanReach(const int32 StartIndex, const int32 EndIndex) const {
+	if (StartIndex == EndIndex || Regions.Num() != Num()) {
+		return true;
+	}
+	const int32 EndRegion = GetRegion(EndIndex);
+	if (EndRegion == INDEX_NONE) {
+		return false;
+	}
+	if (GetRegion(StartIndex) != INDEX_NONE) {
+		return GetRegion(StartIndex) == EndRegion;
+	}
+	const uint8 Mask = NeighborMasks->IsValidIndex(StartIndex) ? NeighborMasks[StartIndex] : 0;
+	for (int32 Direction = 0; Direction < 8; Direction++) {
+		if ((Mask & (1 << Direction)) && Regions[StartIndex + NeighborOffsets[Direction]] == EndRegion) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int32 FTileNavGrid::FloodRegion(const int32 Seed, const int32 OldRegion, const int32 NewRegion) {
+	TArray<int32> Stack = {Seed};
+	Regions[Seed] = NewRegion;
+	int32 Count = 0;
+	while (Stack.Num() > 0) {
+		const int32 Index = Stack.Pop(false);
+		Count++;
+		const uint8 Mask = NeighborMasks[Index];
+		for (int32 Direction = 0; Direction < 8; Direction++) {
+			const int32 NeighborIndex = Index + NeighborOffsets[Direction];
+			if ((Mask & (1 << Direction)) && Regions[NeighborIndex] == OldRegion && IsWalkable(NeighborIndex)) {
+				Regions[NeighborIndex] = NewRegion;
+				Stack.Add(NeighborIndex);
+			}
+		}
+	}
+	return Count;
+}
+
+void FTileNavGrid::JoinRegions(const int32 Index) {
+
+	// The tile joins the largest region around it, and any other region around it is relabeled into that one
+	TArray<int32, TInlineAllocator<8>> Seeds;
+	int32 Largest = INDEX_NONE;
+	const uint8 Mask = NeighborMasks[Index];
+	for (int32 Direction = 0; Direction < 8; Direction++) {
+		const int32 NeighborIndex = Index + NeighborOffsets[Direction];
+		const int32 Region = (Mask & (1 << Direction)) ? Regions[NeighborIndex] : INDEX_NONE;
+		if (Region == INDEX_NONE || Seeds.ContainsByPredicate([this, Region](const int32 Seed) { return Regions[Seed] == Region; })) {
+			continue;
+		}
+		Seeds.Add(NeighborIndex);
+		if (Largest == INDEX_NONE || RegionSizes[Region] > RegionSizes[Largest]) {
+			Largest = Region;
+		}
+	}
+	if (Largest == INDEX_NONE) {
+		Largest = RegionSizes.Add(0);
+	}
+	Regions[Index] = Largest;
+	RegionSizes[Largest]++;
+	for (const int32 Seed: Seeds) {
+		const int32 Region = Regions[Seed];
+		if (Region != Largest) {
+			RegionSizes[Largest] += FloodRegion(Seed, Region, Largest);
+			RegionSizes[Region] = 0;
+		}
+	}
+}
+
+void FTileNavGrid::SplitRegion(const int32 Index) {
+	const int32 OldRegion = Regions[Index];
+	Regions[Index] = INDEX_NONE;
+	RegionSizes[OldRegion]--;
+
+	// Neighbors touching each other stay connected past the blocked tile, so only separate groups of them can have
+	// been cut off from each other
+	TArray<int32, TInlineAllocator<8>> Neighbors;
+	TArray<int32, TInlineAllocator<8>> Groups;
+	const uint8 Mask = NeighborMasks[Index];
+	for (int32 Direction = 0; Direction < 8; Direction++) {
+		const int32 NeighborIndex = Index + NeighborOffsets[Direction];
+		if (!(Mask & (1 << Direction)) || Regions[NeighborIndex] != OldRegion) {
+			continue;
+		}
+		int32 Group = INDEX_NONE;
+		for (int32 Other = 0; Other < Neighbors.Num(); Other++) {
+			const FIntPoint Offset = DirectionOffsets[Direction] - DirectionOffsets[Neighbors[Other]];
+			if (FMath::Abs(Offset.X) <= 1 && FMath::Abs(Offset.Y) <= 1) {
+				if (Group == INDEX_NONE) {
+					Group = Groups[Other];
+				} else if (Groups[Other] != Group) {
+					const int32 Merged = Groups[Other];
+					for (int32& OtherGroup: Groups) {
+						OtherGroup = OtherGroup == Merged ? Group : OtherGroup;
+					}
+				}
+			}
+		}
+		Neighbors.Add(Direction);
+		Groups.Add(Group != INDEX_NONE ? Group : Neighbors.Num() - 1);
+	}
+
+	// Flood out from every group at once, one tile per group in turn, merging groups that meet. A group that runs out
+	// of tiles first was cut off and becomes a new region, so the work done is bounded by the smaller pieces
+	TArray<TArray<int32>, TInlineAllocator<8>> Queues;
+	TArray<int32, TInlineAllocator<8>> Heads;
+	TArray<int32, TInlineAllocator<8>> Parents;
+	TMap<int32, int32> Visited;
+	for (int32 Neighbor = 0; Neighbor < Neighbors.Num(); Neighbor++) {
+		const int32 Group = Groups[Neighbor];
+		if (Group >= Queues.Num()) {
+			Queues.SetNum(Group + 1);
+			Heads.SetNumZeroed(Group + 1);
+			Parents.SetNum(Group + 1);
+		}
+		const int32 NeighborIndex = Index + NeighborOffsets[Neighbors[Neighbor]];
+		Queues[Group].Add(NeighborIndex);
+		Visited.Add(NeighborIndex, Group);
+	}
+	int32 NumActive = 0;
+	for (int32 Group = 0; Group < Queues.Num(); Group++) {
+		Parents[Group] = Group;
+		NumActive += Queues[Group].Num() > 0 ? 1 : 0;
+	}
+	const auto FindRoot = [&Parents](int32 Group) {
+		while (Parents[Group] != Group) {
+			Group = Parents[Group];
+		}
+		return Group;
+	};
+	TArray<bool, TInlineAllocator<8>> Closed;
+	Closed.Init(false, Queues.Num());
+	while (NumActive > 1) {
+		for (int32 Group = 0; Group < Queues.Num() && NumActive > 1; Group++) {
+			if (Queues[Group].Num() == 0 || Closed[Group] || FindRoot(Group) != Group) {
+				continue;
+			}
+			int32 Member = INDEX_NONE;
+			for (int32 Other = 0; Other < Queues.Num() && Member == INDEX_NONE; Other++) {
+				if (Heads[Other] < Queues[Other].Num() && FindRoot(Other) == Group) {
+					Member = Other;
+				}
+			}
+			if (Member == INDEX_NONE) {
+				const int32 NewRegion = RegionSizes.Add(0);
+				for (int32 Other = 0; Other < Queues.Num(); Other++) {
+					if (FindRoot(Other) == Group) {
+						for (const int32 Tile: Queues[Other]) {
+							Regions[Tile] = NewRegion;
+						}
+						RegionSizes[NewRegion] += Queues[Other].Num();
+					}
+				}
+				RegionSizes[OldRegion] -= RegionSizes[NewRegion];
+				Closed[Group] = true;
+				NumActive--;
+				continue;
+			}
+			const int32 Tile = Queues[Member][Heads[Member]++];
+			const uint8 TileMask = NeighborMasks[Tile];
+			for (int32 Direction = 0; Direction < 8; Direction++) {
+				const int32 NeighborIndex = Tile + NeighborOffsets[Direction];
+				if (!(TileMask & (1 << Direction)) || Regions[NeighborIndex] != OldRegion) {
+					continue;
+				}
+				const int32* Visitor = Visited.Find(NeighborIndex);
+				if (!Visitor) {
+					Visited.Add(NeighborIndex, Member);
+					Queues[Member].Add(NeighborIndex);
+				} else if (FindRoot(*Visitor) != Group) {
+					Parents[FindRoot(*Visitor)] = Group;
+					NumActive--;
+				}
+			}
+		}
+	}
+}
+
+bool FTileNavGrid::HasLineOfSight(const int32 StartIndex, const int32 EndIndex, const uint8 MinClearance) const {
+	if (!IsValidTile(StartIndex) || !IsValidTile(EndIndex)) {
+		return false;
+	}
+
+	// Supercover walk from tile center to tile center, visiting every tile the line passes through in order
+	const FIntPoint Start = GetCoord(StartIndex);
+	const FIntPoint End = GetCoord(EndIndex);
+	const int32 StepX = FMath::Sign(End.X - Start.X);
+	const int32 StepY = FMath::Sign(End.Y - Start.Y);
+	const int32 Dx = FMath::Abs(End.X - Start.X) * 2;
+	const int32 Dy = FMath::Abs(End.Y - Start.Y) * 2;
+	int32 Error = (Dx - Dy) / 2;
+	int32 X = Start.X;
+	int32 Y = Start.Y;
+	if (!IsWalkableAt(X, Y, MinClearance)) {
+		return false;
+	}
+	for (int32 Steps = (Dx + Dy) / 2; Steps > 0; Steps--) {
+		if (Error > 0) {
+			X += StepX;
+			Error -= Dy;
+		} else if (Error < 0) {
+			Y += StepY;
+			Error += Dx;
+		} else {
+			if (!IsWalkableAt(X + StepX, Y, MinClearance) || !IsWalkableAt(X, Y + StepY, MinClearance)) {
+				return false;
+			}
+			X += StepX;
+			Y += StepY;
+			Error += Dx - Dy;
+			Steps--;
+		}
+		if (!IsWalkableAt(X, Y, MinClearance)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void FTileNavGrid::UpdateNeighborOffsets() {
+	for (int32 Direction = 0; Direction < 8; Direction++) {
+		NeighborOffsets[Direction] = DirectionOffsets[Direction].Y * Width + DirectionOffsets[Direction].X;
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FTileNavGrid& Grid) {
+	Ar << Grid.Width;
+	Ar << Grid.Height;
+	Ar << Grid.NumTiles;
+	Ar << Grid.Origin;
+	Ar << Grid.Interval;
+	Ar << Grid.ComponentTransform;
+	Ar << Grid.TraceRotation;
+	Grid.Locations.GetForSerialize(Ar).BulkSerialize(Ar);
+	Grid.Flags.BulkSerialize(Ar);
+	Grid.NeighborMasks.GetForSerialize(Ar).BulkSerialize(Ar);
+	if (Ar.CustomVer(FTileNavCustomVersion::GUID) >= FTileNavCustomVersion::QuantizedClearance) {
+		Grid.Clearances.GetForSerialize(Ar).BulkSerialize(Ar);
+		Ar << Grid.ClearanceStep;
+		Ar << Grid.WalkableClearance;
+	} else if (Ar.IsLoading()) {
+
+		// Older clearances were stored in world units. Without the clearance they were built with, agents of every
+		// size are given the walkable tiles as they are
+		Grid.ClearanceStep = Grid.Interval * Grid.ComponentTransform.GetScale3D().GetAbsMin() / FTileNavGrid::ClearanceStepsPerTile;
+		Grid.WalkableClearance = MAX_FLT;
+		Grid.Clearances.Edit().SetNumZeroed(Grid.Num());
+		if (Ar.CustomVer(FTileNavCustomVersion::GUID) >= FTileNavCustomVersion::TileClearance) {
+			TArray<float> Clearances;
+			Clearances.BulkSerialize(Ar);
+			for (int32 Index = 0; Index < Clearances.Num() && Index < Grid.Num(); Index++) {
+				Grid.SetClearance(Index, Clearances[Index]);
+			}
+		}
+	}
+	Ar << Grid.EdgeTiles.GetForSerialize(Ar);
+	if (Ar.CustomVer(FTileNavCustomVersion::GUID) >= FTileNavCustomVersion::PortalGraph) {
+		Ar << Grid.Portals;
+		Grid.PortalCosts.BulkSerialize(Ar);
+	}
+	if (Ar.CustomVer(FTileNavCustomVersion::GUID) >= FTileNavCustomVersion::SectionRouting) {
+		Ar << Grid.CenterTile;
+		Grid.CenterPortalCosts.BulkSerialize(Ar);
+	} else if (Ar.IsLoading()) {
+		Grid.CenterTile = INDEX_NONE;
+		Grid.CenterPortalCosts.Init(MAX_FLT, Grid.Portals.Num());
+	}
+
+	if (Ar.CustomVer(FTileNavCustomVersion::GUID) >= FTileNavCustomVersion::Landmarks) {
+		Grid.Landmarks.BulkSerialize(Ar);
+		Grid.LandmarkDistances.GetForSerialize(Ar).BulkSerialize(Ar);
+		Ar << Grid.LandmarkStep;
+	}
+	if (Ar.CustomVer(FTileNavCustomVersion::GUID) >= FTileNavCustomVersion::Clusters) {
+		Ar << Grid.Clusters;
+	}
+
+	if (Ar.IsLoading()) {
+		if (Grid.Locations->Num() != Grid.Num() || Grid.Flags.Num() != Grid.Num() || Grid.NeighborMasks->Num() != Grid.Num() || Grid.Clearances->Num() != Grid.Num() ||
+			Grid.PortalCosts.Num() != Grid.Portals.Num() * Grid.Portals.Num() || Grid.CenterPortalCosts.Num() != Grid.Portals.Num() ||
+			Grid.LandmarkDistances->Num() != Grid.Landmarks.Num() * Grid.Num() || Grid.Clusters.Clusters.Num() != Grid.Clusters.ClustersX * Grid.Clusters.ClustersY) {
+			Ar.SetError();
+			Grid.Reset();
+		}
+		Grid.UpdateNeighborOffsets();
+		Grid.UpdateTileBounds();
+		Grid.BuildRegions();
+	}
+	return Ar;
+}
+
+SIZE_T FTileNavGrid::GetAllocatedSize() const {
+	return Locations->GetAllocatedSize() + Flags.GetAllocatedSize() + NeighborMasks->GetAllocatedSize() + Clearances->GetAllocatedSize() + EdgeTiles->GetAllocatedSize() +
+		Portals.GetAllocatedSize() + PortalCosts.GetAllocatedSize() + CenterPortalCosts.GetAllocatedSize() + Regions.GetAllocatedSize() + RegionSizes.GetAllocatedSize() +
+		Landmarks.GetAllocatedSize() + LandmarkDistances->GetAllocatedSize() + Clusters.GetAllocatedSize();
+}
+
+bool FTileNavGrid::FindPath(
+	const int32 StartIndex,
+	const int32 EndIndex,
+	const ETileNavSearchMode Mode,
+	TArray<int32>& OutPath,
+	FTileNavSearchStats& Stats,
+	const uint8 MinClearance,
+	const bool bAllowBidirectional) const {
+
+	if (!IsValidTile(StartIndex) || !IsValidTile(EndIndex)) return false;
+
+	// Tiles in different regions are rejected without searching the whole region around the start
+	if (!CanReach(StartIndex, EndIndex)) return false;
+	const double StartTime = FPlatformTime::Seconds();
+	bool bFound;
+	switch (Mode) {
+		case ETileNavSearchMode::JumpPoint:
+			bFound = FindPathJumpPoint(StartIndex, EndIndex, OutPath, Stats, MinClearance);
+			break;
+		case ETileNavSearchMode::ThetaStar:
+			bFound = FindPathThetaStar(StartIndex, EndIndex, OutPath, Stats, MinClearance);
+			break;
+		default:
+			bFound = bAllowBidirectional && IsBidirectional(StartIndex, EndIndex, Mode)
+				? FindPathBidirectional(StartIndex, EndIndex, OutPath, Stats, MinClearance)
+				: FindPathAStar(StartIndex, EndIndex, OutPath, Stats, MinClearance);
+			break;
+	}
+	Stats.Milliseconds += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	return bFound;
+}
+
+void FTileNavGrid::FindPath(
+	const FVector& Start,
+	const FVector& End,
+	const ETileNavSearchMode Mode,
+	bool& bFound,
+	TArray<FVector>& PathTiles,
+	FTileNavSearchStats& Stats,
+	const uint8 MinClearance) const {
+
+	const int32 StartIndex = GetTileIndex(Start);
+	const int32 EndIndex = GetTileIndex(End);
+	if (StartIndex == INDEX_NONE || EndIndex == INDEX_NONE || StartIndex == EndIndex) return;
+
+	TArray<int32> PathIndices;
+	bFound = FindPath(StartIndex, EndIndex, Mode, PathIndices, Stats, MinClearance);
+	for (auto& Index: PathIndices) {
+		PathTiles.Add(Locations[Index]);
+	}
+}
+
+bool FTileNavGrid::FindPathAStar(const int32 StartIndex, const int32 EndIndex, TArray<int32>& OutPath, FTileNavSearchStats& Stats, const uint8 MinClearance, const bool bLandmarks) const {
+	const FVector& End = Locations[EndIndex];
+	const bool bUseLandmarks = bLandmarks && Landmarks.Num() > 0;
+	TileNavSearch::FSearchState& Search = TileNavSearch::GetThreadSearchState();
+	Search.Reset(Num());
+	Search.Open(StartIndex, INDEX_NONE, 0.0f, bUseLandmarks ? GetHeuristic(StartIndex, EndIndex) : FVector::Distance(Locations[StartIndex], End));
+
+	FPathTile CurrentPathTile;
+	while (Search.PopBest(CurrentPathTile)) {
+		Stats.Expansions++;
+		if (CurrentPathTile.Index == EndIndex) {
+			Search.AppendPath(EndIndex, OutPath);
+			return true;
+		}
+
+		const FVector& CurrentLocation = Locations[CurrentPathTile.Index];
+		const uint8 Mask = NeighborMasks[CurrentPathTile.Index];
+		for (int32 Direction = 0; Direction < 8; Direction++) {
+			if (!(Mask & (1 << Direction))) {
+				continue;
+			}
+			const int32 ChildIndex = CurrentPathTile.Index + NeighborOffsets[Direction];
+			if (!IsWalkable(ChildIndex, MinClearance)) {
+				continue;
+			}
+			Search.Open(
+				ChildIndex,
+				CurrentPathTile.Index,
+				CurrentPathTile.G + FVector::Distance(Locations[ChildIndex], CurrentLocation),
+				bUseLandmarks ? GetHeuristic(ChildIndex, EndIndex) : FVector::Distance(Locations[ChildIndex], End)
+			);
+		}
+	}
+	return false;
+}
+
+bool FTileNavGrid::IsBidirectional(const int32 StartIndex, const int32 EndIndex, const ETileNavSearchMode Mode) const {
+	return Mode == ETileNavSearchMode::AStar && Landmarks.Num() == 0 && BidirectionalDistance < MAX_FLT &&
+		FVector::DistSquared(Locations[StartIndex], Locations[EndIndex]) > FMath::Square(BidirectionalDistance);
+}
+
+bool FTileNavGrid::FindPathBidirectional(const int32 StartIndex, const int32 EndIndex, TArray<int32>& OutPath, FTileNavSearchStats& Stats, const uint8 MinClearance) const {
+	if (!IsWalkable(EndIndex, MinClearance)) {
+		return false;
+	}
+
+	// Side 0 searches forwards from the start and side 1 backwards from the end, each estimating the distance to the
+	// other's origin. The straight line is used even with landmarks, as the rejection test needs a consistent estimate
+	const int32 Origins[2] = {StartIndex, EndIndex};
+	const auto Heuristic = [this, &Origins](const int32 Side, const int32 Index) {
+		return FVector::Distance(Locations[Index], Locations[Origins[1 - Side]]);
+	};
+	TileNavSearch::FSearchState* Searches[2] = {&TileNavSearch::GetThreadSearchState(0), &TileNavSearch::GetThreadSearchState(1)};
+	float LowestF[2];
+	for (int32 Side = 0; Side < 2; Side++) {
+		Searches[Side]->Reset(Num());
+		Searches[Side]->Open(Origins[Side], INDEX_NONE, 0.0f, Heuristic(Side, Origins[Side]));
+		LowestF[Side] = Searches[Side]->OpenHeap.HeapTop().F;
+	}
+
+	float BestLength = MAX_FLT;
+	int32 MeetIndex = INDEX_NONE;
+	FPathTile CurrentPathTile;
+	while (Searches[0]->OpenHeap.Num() > 0 && Searches[1]->OpenHeap.Num() > 0) {
+
+		// Expand the side with the smaller frontier. A tile closed by either side is closed to both
+		const int32 Side = Searches[0]->OpenHeap.Num() <= Searches[1]->OpenHeap.Num() ? 0 : 1;
+		TileNavSearch::FSearchState& Search = *Searches[Side];
+		const TileNavSearch::FSearchState& OtherSearch = *Searches[1 - Side];
+		if (Search.PopBest(CurrentPathTile) && OtherSearch.GetState(CurrentPathTile.Index) != TileNavSearch::ETileState::Closed) {
+			const int32 CurrentIndex = CurrentPathTile.Index;
+			Stats.Expansions++;
+			const float OtherG = OtherSearch.GetG(CurrentIndex);
+			if (OtherG < MAX_FLT && CurrentPathTile.G + OtherG < BestLength) {
+				BestLength = CurrentPathTile.G + OtherG;
+				MeetIndex = CurrentIndex;
+			}
+
+			// Stale heap entries can only lower the other side's lowest F, which rejects fewer tiles but never wrongly
+			if (CurrentPathTile.F < BestLength && CurrentPathTile.G + LowestF[1 - Side] - Heuristic(1 - Side, CurrentIndex) < BestLength) {
+				const FVector& CurrentLocation = Locations[CurrentIndex];
+				const uint8 Mask = NeighborMasks[CurrentIndex];
+				for (int32 Direction = 0; Direction < 8; Direction++) {
+					if (!(Mask & (1 << Direction))) {
+						continue;
+					}
+
+					// The backward search may step onto the start even when it is not walkable, as the forward search starts there
+					const int32 ChildIndex = CurrentIndex + NeighborOffsets[Direction];
+					if (OtherSearch.GetState(ChildIndex) == TileNavSearch::ETileState::Closed ||
+						!(IsWalkable(ChildIndex, MinClearance) || (Side == 1 && ChildIndex == StartIndex))) {
+						continue;
+					}
+					const float ChildG = CurrentPathTile.G + FVector::Distance(Locations[ChildIndex], CurrentLocation);
+					if (!Search.Open(ChildIndex, CurrentIndex, ChildG, Heuristic(Side, ChildIndex))) {
+						continue;
+					}
+					const float ChildOtherG = OtherSearch.GetG(ChildIndex);
+					if (ChildOtherG < MAX_FLT && ChildG + ChildOtherG < BestLength) {
+						BestLength = ChildG + ChildOtherG;
+						MeetIndex = ChildIndex;
+					}
+				}
+			}
+		}
+		LowestF[Side] = Search.OpenHeap.Num() > 0 ? Search.OpenHeap.HeapTop().F : MAX_FLT;
+	}
+	if (MeetIndex == INDEX_NONE) {
+		return false;
+	}
+
+	// Forward parents lead back from the meeting tile to the start, and backward parents on to the end
+	Searches[0]->AppendPath(MeetIndex, OutPath);
+	for (int32 Index = Searches[1]->Parents[MeetIndex]; Index != INDEX_NONE; Index = Searches[1]->Parents[Index]) {
+		OutPath.Add(Index);
+	}
+	return true;
+}
+
+bool FTileNavGrid::FindPathThetaStar(const int32 StartIndex, const int32 EndIndex, TArray<int32>& OutPath, FTileNavSearchStats& Stats, const uint8 MinClearance) const {
+	const FVector& End = Locations[EndIndex];
+	TileNavSearch::FSearchState& Search = TileNavSearch::GetThreadSearchState();
+	Search.Reset(Num());
+	Search.Open(StartIndex, INDEX_NONE, 0.0f, FVector::Distance(Locations[StartIndex], End));
+
+	FPathTile CurrentPathTile;
+	while (Search.PopBest(CurrentPathTile)) {
+		Stats.Expansions++;
+		const int32 Current = CurrentPathTile.Index;
+
+		// Children are opened assuming their grandparent is in sight. Check it once the tile is expanded, and if it is
+		// not, fall back to the best closed neighbor as an ordinary grid step
+		int32 Parent = Search.Parents[Current];
+		if (Parent != INDEX_NONE && !HasLineOfSight(Parent, Current, MinClearance)) {
+			float BestG = MAX_FLT;
+			const uint8 Mask = NeighborMasks[Current];
+			for (int32 Direction = 0; Direction < 8; Direction++) {
+				const int32 NeighborIndex = Current + NeighborOffsets[Direction];
+				if ((Mask & (1 << Direction)) && Search.GetState(NeighborIndex) == TileNavSearch::ETileState::Closed) {
+					const float NeighborG = Search.G[NeighborIndex] + FVector::Distance(Locations[NeighborIndex], Locations[Current]);
+					if (NeighborG < BestG) {
+						BestG = NeighborG;
+						Parent = NeighborIndex;
+					}
+				}
+			}
+			Search.G[Current] = BestG;
+			Search.Parents[Current] = Parent;
+		}
+		if (Current == EndIndex) {
+			Search.AppendPath(EndIndex, OutPath);
+			return true;
+		}
+
+		// Tiles are linked straight to this tile's parent, or to this tile if it is the start
+		const int32 LinkIndex = Parent != INDEX_NONE ? Parent : Current;
+		const FVector& LinkLocation = Locations[LinkIndex];
+		const uint8 Mask = NeighborMasks[Current];
+		for (int32 Direction = 0; Direction < 8; Direction++) {
+			if (!(Mask & (1 << Direction))) {
+				continue;
+			}
+			const int32 ChildIndex = Current + NeighborOffsets[Direction];
+			if (!IsWalkable(ChildIndex, MinClearance)) {
+				continue;
+			}
+			Search.Open(
+				ChildIndex,
+				LinkIndex,
+				Search.G[LinkIndex] + FVector::Distance(Locations[ChildIndex], LinkLocation),
+				FVector::Distance(Locations[ChildIndex], End)
+			);
+		}
+	}
+	return false;
+}
+
+bool FTileNavGrid::FindPathJumpPoint(const int32 StartIndex, const int32 EndIndex, TArray<int32>& OutPath, FTileNavSearchStats& Stats, const uint8 MinClearance) const {
+	const FVector& End = Locations[EndIndex];
+	TileNavSearch::FSearchState& Search = TileNavSearch::GetThreadSearchState();
+	Search.Reset(Num());
+	Search.Open(StartIndex, INDEX_NONE, 0.0f, FVector::Distance(Locations[StartIndex], End));
+
+	FPathTile CurrentPathTile;
+	while (Search.PopBest(CurrentPathTile)) {
+		Stats.Expansions++;
+		if (CurrentPathTile.Index == EndIndex) {
+			Search.AppendPath(EndIndex, OutPath);
+			return true;
+		}
+
+		// Prune the neighbors using the direction of travel from the parent jump point. Diagonal moves are always
+		// allowed, matching the A* movement model, so forced neighbors appear beside blocked orthogonal tiles
+		const FIntPoint Coord = GetCoord(CurrentPathTile.Index);
+		const int32 X = Coord.X;
+		const int32 Y = Coord.Y;
+		FIntPoint Directions[8];
+		int32 NumDirections = 0;
+		if (CurrentPathTile.Parent == INDEX_NONE) {
+			for (int32 Direction = 0; Direction < 8; Direction++) {
+				Directions[NumDirections++] = DirectionOffsets[Direction];
+			}
+		} else {
+			const FIntPoint ParentCoord = GetCoord(CurrentPathTile.Parent);
+			const int32 Dx = FMath::Sign(X - ParentCoord.X);
+			const int32 Dy = FMath::Sign(Y - ParentCoord.Y);
+			if (Dx != 0 && Dy != 0) {
+				Directions[NumDirections++] = FIntPoint(0, Dy);
+				Directions[NumDirections++] = FIntPoint(Dx, 0);
+				Directions[NumDirections++] = FIntPoint(Dx, Dy);
+				if (!IsWalkableAt(X - Dx, Y, MinClearance)) {
+					Directions[NumDirections++] = FIntPoint(-Dx, Dy);
+				}
+				if (!IsWalkableAt(X, Y - Dy, MinClearance)) {
+					Directions[NumDirections++] = FIntPoint(Dx, -Dy);
+				}
+			} else if (Dx == 0) {
+				Directions[NumDirections++] = FIntPoint(0, Dy);
+				if (!IsWalkableAt(X + 1, Y, MinClearance)) {
+					Directions[NumDirections++] = FIntPoint(1, Dy);
+				}
+				if (!IsWalkableAt(X - 1, Y, MinClearance)) {
+					Directions[NumDirections++] = FIntPoint(-1, Dy);
+				}
+			} else {
+				Directions[NumDirections++] = FIntPoint(Dx, 0);
+				if (!IsWalkableAt(X, Y + 1, MinClearance)) {
+					Directions[NumDirections++] = FIntPoint(Dx, 1);
+				}
+				if (!IsWalkableAt(X, Y - 1, MinClearance)) {
+					Directions[NumDirections++] = FIntPoint(Dx, -1);
+				}
+			}
+		}
+
+		const FVector& CurrentLocation = Locations[CurrentPathTile.Index];
+		for (int32 Direction = 0; Direction < NumDirections; Direction++) {
+			const int32 JumpIndex = Jump(X + Directions[Direction].X, Y + Directions[Direction].Y, Directions[Direction].X, Directions[Direction].Y, EndIndex, MinClearance);
+			if (JumpIndex == INDEX_NONE) {
+				continue;
+			}
+			Search.Open(
+				JumpIndex,
+				CurrentPathTile.Index,
+				CurrentPathTile.G + FVector::Distance(Locations[JumpIndex], CurrentLocation),
+				FVector::Distance(Locations[JumpIndex], End)
+			);
+		}
+	}
+	return false;
+}
+
+int32 FTileNavGrid::Jump(int32 X, int32 Y, const int32 Dx, const int32 Dy, const int32 EndIndex, const uint8 MinClearance) const {
+	while (IsWalkableAt(X, Y, MinClearance)) {
+		const int32 Index = GetIndex(X, Y);
+		if (Index == EndIndex) {
+			return Index;
+		}
+		if (Dx != 0 && Dy != 0) {
+			if ((IsWalkableAt(X - Dx, Y + Dy, MinClearance) && !IsWalkableAt(X - Dx, Y, MinClearance)) ||
+				(IsWalkableAt(X + Dx, Y - Dy, MinClearance) && !IsWalkableAt(X, Y - Dy, MinClearance))) {
+				return Index;
+			}
+
+			// A diagonal step is a jump point if either of its straight components reaches one
+			if (Jump(X + Dx, Y, Dx, 0, EndIndex, MinClearance) != INDEX_NONE || Jump(X, Y + Dy, 0, Dy, EndIndex, MinClearance) != INDEX_NONE) {
+				return Index;
+			}
+		} else if (Dx != 0) {
+			if ((IsWalkableAt(X + Dx, Y + 1, MinClearance) && !IsWalkableAt(X, Y + 1, MinClearance)) ||
+				(IsWalkableAt(X + Dx, Y - 1, MinClearance) && !IsWalkableAt(X, Y - 1, MinClearance))) {
+				return Index;
+			}
+		} else {
+			if ((IsWalkableAt(X + 1, Y + Dy, MinClearance) && !IsWalkableAt(X + 1, Y, MinClearance)) ||
+				(IsWalkableAt(X - 1, Y + Dy, MinClearance) && !IsWalkableAt(X - 1, Y, MinClearance))) {
+				return Index;
+			}
+		}
+		X += Dx;
+		Y += Dy;
+	}
+	return INDEX_NONE;
+}
+
+void FTileNavGrid::BuildPortals() {
+	Portals.Reset();
+	PortalCosts.Reset();
+
+	TArray<int32> TargetSections;
+	for (auto& Tile: EdgeTiles) {
+		for (const int32 NavSection: Tile.Value.NavSections) {
+			TargetSections.AddUnique(NavSection);
+		}
+	}
+	TargetSections.Sort();
+
+	// Each 8-connected run of edge tiles linked to the same section becomes one portal, represented by its walkable
+	// tile nearest to the middle of the run. Runs without a walkable tile are left out
+	for (const int32 TargetSection: TargetSections) {
+		TSet<int32> Unvisited;
+		for (auto& Tile: EdgeTiles) {
+			if (Tile.Value.NavSections.Contains(TargetSection)) {
+				Unvisited.Add(Tile.Key);
+			}
+		}
+		for (auto& Tile: EdgeTiles) {
+			if (!Unvisited.Contains(Tile.Key)) {
+				continue;
+			}
+			TArray<int32> Run;
+			TArray<int32> Stack = {Tile.Key};
+			Unvisited.Remove(Tile.Key);
+			FVector RunCenter = FVector::ZeroVector;
+			while (Stack.Num() > 0) {
+				const int32 Index = Stack.Pop(false);
+				Run.Add(Index);
+				RunCenter += Locations[Index];
+				const FIntPoint Coord = GetCoord(Index);
+				for (int32 Direction = 0; Direction < 8; Direction++) {
+					const int32 Nx = Coord.X + DirectionOffsets[Direction].X;
+					const int32 Ny = Coord.Y + DirectionOffsets[Direction].Y;
+					if (IsInBounds(Nx, Ny) && Unvisited.Remove(GetIndex(Nx, Ny)) > 0) {
+						Stack.Add(GetIndex(Nx, Ny));
+					}
+				}
+			}
+			RunCenter /= Run.Num();
+
+			int32 PortalTile = INDEX_NONE;
+			float NearestDistance = MAX_FLT;
+			for (const int32 Index: Run) {
+				const float Distance = FVector::DistSquared(RunCenter, Locations[Index]);
+				if (IsWalkable(Index) && Distance < NearestDistance) {
+					NearestDistance = Distance;
+					PortalTile = Index;
+				}
+			}
+			if (PortalTile != INDEX_NONE) {
+				Portals.Add(FTileNavPortal(PortalTile, TargetSection));
+			}
+		}
+	}
+
+	PortalCosts.SetNumUninitialized(Portals.Num() * Portals.Num());
+	TArray<float> Distances;
+	FTileNavSearchStats Stats;
+	for (int32 Portal = 0; Portal < Portals.Num(); Portal++) {
+		ComputePortalDistances(Portals[Portal].TileIndex, Distances, Stats);
+		FMemory::Memcpy(&PortalCosts[Portal * Portals.Num()], Distances.GetData(), Portals.Num() * sizeof(float));
+	}
+
+	CenterTile = FindNearestWalkableTile(TileBounds.GetCenter());
+	ComputePortalDistances(CenterTile, CenterPortalCosts, Stats);
+}
+
+float FTileNavGrid::GetCenterCost(const int32 TargetSection, int32& OutPortal) const {
+	OutPortal = INDEX_NONE;
+	float BestCost = MAX_FLT;
+	for (int32 Portal = 0; Portal < Portals.Num(); Portal++) {
+		if (Portals[Portal].TargetSection != TargetSection) {
+			continue;
+		}
+		float Cost = CenterPortalCosts[Portal];
+		if (Cost == MAX_FLT) {
+			Cost = FVector::Distance(GetCenterLocation(), Locations[Portals[Portal].TileIndex]);
+		}
+		if (Cost < BestCost) {
+			BestCost = Cost;
+			OutPortal = Portal;
+		}
+	}
+	return BestCost;
+}
+
+FVector FTileNavGrid::GetCenterLocation() const {
+	return IsValidTile(CenterTile) ? Locations[CenterTile] : TileBounds.GetCenter();
+}
+
+void FTileNavGrid::ComputePortalDistances(const int32 StartIndex, TArray<float>& OutDistances, FTileNavSearchStats& Stats, const uint8 MinClearance) const {
+	OutDistances.Init(MAX_FLT, Portals.Num());
+	if (Portals.Num() == 0 || !IsValidTile(StartIndex) || !IsWalkable(StartIndex)) {
+		return;
+	}
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Several portals can share a tile, so count the distinct tiles still to be reached
+	TArray<int32> PortalTiles;
+	for (auto& Portal: Portals) {
+		PortalTiles.AddUnique(Portal.TileIndex);
+	}
+	int32 RemainingTiles = PortalTiles.Num();
+
+	// Dijkstra over the same moves as FindPathAStar, which is A* with a zero heuristic
+	TileNavSearch::FSearchState& Search = TileNavSearch::GetThreadSearchState();
+	Search.Reset(Num());
+	Search.Open(StartIndex, INDEX_NONE, 0.0f, 0.0f);
+	FPathTile CurrentPathTile;
+	while (RemainingTiles > 0 && Search.PopBest(CurrentPathTile)) {
+		Stats.Expansions++;
+		if (PortalTiles.Contains(CurrentPathTile.Index)) {
+			RemainingTiles--;
+		}
+		const FVector& CurrentLocation = Locations[CurrentPathTile.Index];
+		const uint8 Mask = NeighborMasks[CurrentPathTile.Index];
+		for (int32 Direction = 0; Direction < 8; Direction++) {
+			if (!(Mask & (1 << Direction))) {
+				continue;
+			}
+			const int32 ChildIndex = CurrentPathTile.Index + NeighborOffsets[Direction];
+			if (IsWalkable(ChildIndex, MinClearance)) {
+				Search.Open(ChildIndex, CurrentPathTile.Index, CurrentPathTile.G + FVector::Distance(Locations[ChildIndex], CurrentLocation), 0.0f);
+			}
+		}
+	}
+	for (int32 Portal = 0; Portal < Portals.Num(); Portal++) {
+		const int32 TileIndex = Portals[Portal].TileIndex;
+		if (Search.GetState(TileIndex) == TileNavSearch::ETileState::Closed) {
+			OutDistances[Portal] = Search.G[TileIndex];
+		}
+	}
+	Stats.Milliseconds += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+}
+
+void FTileNavGrid::ComputeTileDistances(const int32 StartIndex, TArray<float>& OutDistances) const {
+	OutDistances.Init(MAX_FLT, Num());
+	if (!IsValidTile(StartIndex) || !IsWalkable(StartIndex)) {
+		return;
+	}
+	TileNavSearch::FSearchState& Search = TileNavSearch::GetThreadSearchState();
+	Search.Reset(Num());
+	Search.Open(StartIndex, INDEX_NONE, 0.0f, 0.0f);
+	FPathTile CurrentPathTile;
+	while (Search.PopBest(CurrentPathTile)) {
+		OutDistances[CurrentPathTile.Index] = CurrentPathTile.G;
+		const FVector& CurrentLocation = Locations[CurrentPathTile.Index];
+		const uint8 Mask = NeighborMasks[CurrentPathTile.Index];
+		for (int32 Direction = 0; Direction < 8; Direction++) {
+			if (!(Mask & (1 << Direction))) {
+				continue;
+			}
+			const int32 ChildIndex = CurrentPathTile.Index + NeighborOffsets[Direction];
+			if (IsWalkable(ChildIndex)) {
+				Search.Open(ChildIndex, CurrentPathTile.Index, CurrentPathTile.G + FVector::Distance(Locations[ChildIndex], CurrentLocation), 0.0f);
+			}
+		}
+	}
+}
+
+void FTileNavGrid::BuildLandmarks(const int32 NumLandmarks) {
+	Landmarks.Reset();
+	LandmarkDistances.Empty();
+	LandmarkStep = 1.0f;
+	int32 LargestRegion = INDEX_NONE;
+	for (int32 Region = 0; Region < RegionSizes.Num(); Region++) {
+		if (RegionSizes[Region] > 1 && (LargestRegion == INDEX_NONE || RegionSizes[Region] > RegionSizes[LargestRegion])) {
+			LargestRegion = Region;
+		}
+	}
+	if (NumLandmarks <= 0 || LargestRegion == INDEX_NONE) {
+		return;
+	}
+
+	// Farthest point selection. The first landmark is the tile farthest from an arbitrary tile of the region, and
+	// each one after is the tile farthest from its nearest landmark, which pushes landmarks out to the dead ends and
+	// corners that bound distances best
+	TArray<TArray<float>> Distances;
+	TArray<float> NearestDistances;
+	ComputeTileDistances(Regions.IndexOfByKey(LargestRegion), NearestDistances);
+	float MaxDistance = 0.0f;
+	while (Landmarks.Num() < NumLandmarks) {
+		int32 Farthest = INDEX_NONE;
+		float FarthestDistance = 0.0f;
+		for (int32 Index = 0; Index < Num(); Index++) {
+			if (NearestDistances[Index] < MAX_FLT && NearestDistances[Index] > FarthestDistance) {
+				FarthestDistance = NearestDistances[Index];
+				Farthest = Index;
+			}
+		}
+		if (Farthest == INDEX_NONE) {
+			break;
+		}
+		Landmarks.Add(Farthest);
+		TArray<float>& LandmarkRow = Distances.AddDefaulted_GetRef();
+		ComputeTileDistances(Farthest, LandmarkRow);
+		for (int32 Index = 0; Index < Num(); Index++) {
+			NearestDistances[Index] = FMath::Min(NearestDistances[Index], LandmarkRow[Index]);
+			if (LandmarkRow[Index] < MAX_FLT) {
+				MaxDistance = FMath::Max(MaxDistance, LandmarkRow[Index]);
+			}
+		}
+	}
+
+	// Steps are as fine as the longest distance allows, leaving MAX_uint16 free to mark unreachable tiles
+	LandmarkStep = FMath::Max(MaxDistance / (MAX_uint16 - 1), KINDA_SMALL_NUMBER);
+	TArray<uint16>& StoredDistances = LandmarkDistances.Edit();
+	StoredDistances.SetNumUninitialized(Num() * Landmarks.Num());
+	for (int32 Index = 0; Index < Num(); Index++) {
+		for (int32 Landmark = 0; Landmark < Landmarks.Num(); Landmark++) {
+			const float Distance = Distances[Landmark][Index];
+			StoredDistances[Index * Landmarks.Num() + Landmark] = Distance < MAX_FLT
+				? static_cast<uint16>(FMath::Min(FMath::FloorToInt(Distance / LandmarkStep), MAX_uint16 - 1))
+				: MAX_uint16;
+		}
+	}
+}
+
+void FTileNavGrid::BuildClusters(const int32 ClusterSize, const int32 MinTiles) {
+	Clusters.Build(*this, NumTiles >= MinTiles ? ClusterSize : 0);
+}
+
+void FTileNavGrid::MeasureLandmarks(const int32 NumQueries, FTileNavSearchStats& OutPlainStats, FTileNavSearchStats& OutLandmarkStats) const {
+	if (Landmarks.Num() == 0) {
+		return;
+	}
+	TArray<int32> RegionTiles;
+	const int32 Region = GetRegion(Landmarks[0]);
+	for (int32 Index = 0; Index < Num(); Index++) {
+		if (Regions[Index] == Region) {
+			RegionTiles.Add(Index);
+		}
+	}
+	FRandomStream Stream(RegionTiles.Num());
+	TArray<int32> Path;
+	for (int32 Query = 0; Query < NumQueries; Query++) {
+		const int32 StartIndex = RegionTiles[Stream.RandHelper(RegionTiles.Num())];
+		const int32 EndIndex = RegionTiles[Stream.RandHelper(RegionTiles.Num())];
+		double StartTime = FPlatformTime::Seconds();
+		FindPathAStar(StartIndex, EndIndex, Path, OutPlainStats, 0, false);
+		OutPlainStats.Milliseconds += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		Path.Reset();
+		StartTime = FPlatformTime::Seconds();
+		FindPathAStar(StartIndex, EndIndex, Path, OutLandmarkStats, 0, true);
+		OutLandmarkStats.Milliseconds += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		Path.Reset();
+	}
+}
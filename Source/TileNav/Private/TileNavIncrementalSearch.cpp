@@ -0,0 +1,233 @@
+#include "TileNavIncrementalSearch.h"
+
+FTileNavIncrementalSearch::FTileNavIncrementalSearch(
+	const FTileNavGridConstPtr& InGrid,
+	const int32 InSection,
+	const int32 InStartTile,
+	const int32 InGoalTile,
+	const uint8 InMinClearance):
+	Grid(InGrid), Section(InSection), StartTile(InStartTile), GoalTile(InGoalTile), MinClearance(InMinClearance),
+	KeyModifier(0.0f), LastStartTile(InStartTile), NextStamp(0) {
+}
+
+bool FTileNavIncrementalSearch::Search(FTileNavSearchStats& Stats) {
+	Nodes.Reset();
+	Open.Reset();
+	KeyModifier = 0.0f;
+	LastStartTile = StartTile;
+	if (!Grid.IsValid() || !Grid->IsValidTile(StartTile) || !Grid->IsValidTile(GoalTile)) {
+		return false;
+	}
+	SetRhs(GoalTile, 0.0f);
+	UpdateTile(GoalTile);
+	return ComputeShortestPath(Stats);
+}
+
+bool FTileNavIncrementalSearch::Repair(const FTileNavGridConstPtr& NewGrid, const TArray<int32>& ChangedTiles, const int32 NewStartTile, FTileNavSearchStats& Stats) {
+	if (!NewGrid.IsValid() || !Grid.IsValid() || NewGrid->Num() != Grid->Num()) {
+		return false;
+	}
+	Grid = NewGrid;
+	if (NewStartTile != INDEX_NONE && NewStartTile != StartTile) {
+		StartTile = NewStartTile;
+		KeyModifier += GetHeuristic(LastStartTile, StartTile);
+		LastStartTile = StartTile;
+	}
+
+	// A tile's walkability only changes the cost of stepping onto it, so the tiles around it are the only ones whose
+	// cheapest step needs looking at again
+	const FTileNavGrid& TileGrid = *Grid;
+	for (const int32 Tile: ChangedTiles) {
+		if (!TileGrid.IsValidTile(Tile)) {
+			continue;
+		}
+		const uint8 Mask = TileGrid.NeighborMasks[Tile];
+		for (int32 Direction = 0; Direction < 8; Direction++) {
+			const int32 NeighborTile = Tile + TileGrid.NeighborOffsets[Direction];
+			if ((Mask & (1 << Direction)) && NeighborTile != GoalTile) {
+				SetRhs(NeighborTile, ComputeRhs(NeighborTile));
+				UpdateTile(NeighborTile);
+			}
+		}
+	}
+	return ComputeShortestPath(Stats);
+}
+
+bool FTileNavIncrementalSearch::GetPath(TArray<int32>& OutPath) const {
+	OutPath.Reset();
+	if (!Grid.IsValid() || GetG(StartTile) == MAX_FLT) {
+		return false;
+	}
+	const FTileNavGrid& TileGrid = *Grid;
+	int32 Tile = StartTile;
+	OutPath.Add(Tile);
+	while (Tile != GoalTile) {
+		int32 NextTile = INDEX_NONE;
+		float NextCost = MAX_FLT;
+		const uint8 Mask = TileGrid.NeighborMasks[Tile];
+		for (int32 Direction = 0; Direction < 8; Direction++) {
+			const int32 NeighborTile = Tile + TileGrid.NeighborOffsets[Direction];
+			if (!(Mask & (1 << Direction))) {
+				continue;
+			}
+			const float G = GetG(NeighborTile);
+			const float Cost = G < MAX_FLT ? GetCost(Tile, NeighborTile) : MAX_FLT;
+			if (Cost < MAX_FLT && Cost + G < NextCost) {
+				NextCost = Cost + G;
+				NextTile = NeighborTile;
+			}
+		}
+		if (NextTile == INDEX_NONE || OutPath.Num() > TileGrid.Num()) {
+			OutPath.Reset();
+			return false;
+		}
+		Tile = NextTile;
+		OutPath.Add(Tile);
+	}
+	return true;
+}
+
+SIZE_T FTileNavIncrementalSearch::GetAllocatedSize() const {
+	return Nodes.GetAllocatedSize() + Open.GetAllocatedSize();
+}
+
+float FTileNavIncrementalSearch::GetCost(const int32 From, const int32 To) const {
+	return Grid->IsWalkable(To, MinClearance) ? FVector::Distance(Grid->Locations[From], Grid->Locations[To]) : MAX_FLT;
+}
+
+float FTileNavIncrementalSearch::GetHeuristic(const int32 From, const int32 To) const {
+	return FVector::Distance(Grid->Locations[From], Grid->Locations[To]);
+}
+
+FTileNavIncrementalSearch::FOpenEntry FTileNavIncrementalSearch::MakeEntry(const int32 Tile) const {
+	const float Distance = FMath::Min(GetG(Tile), GetRhs(Tile));
+	FOpenEntry Entry;
+	Entry.Key1 = Distance < MAX_FLT ? Distance + GetHeuristic(StartTile, Tile) + KeyModifier : MAX_FLT;
+	Entry.Key2 = Distance;
+	Entry.Tile = Tile;
+	Entry.Stamp = 0;
+	return Entry;
+}
+
+float FTileNavIncrementalSearch::ComputeRhs(const int32 Tile) const {
+	if (Tile == GoalTile) {
+		return 0.0f;
+	}
+	const FTileNavGrid& TileGrid = *Grid;
+	float Rhs = MAX_FLT;
+	const uint8 Mask = TileGrid.NeighborMasks[Tile];
+	for (int32 Direction = 0; Direction < 8; Direction++) {
+		const int32 NeighborTile = Tile + TileGrid.NeighborOffsets[Direction];
+		if (!(Mask & (1 << Direction))) {
+			continue;
+		}
+		const float G = GetG(NeighborTile);
+		if (G < MAX_FLT) {
+			const float Cost = GetCost(Tile, NeighborTile);
+			if (Cost < MAX_FLT) {
+				Rhs = FMath::Min(Rhs, Cost + G);
+			}
+		}
+	}
+	return Rhs;
+}
+
+void FTileNavIncrementalSearch::SetRhs(const int32 Tile, const float Rhs) {
+	FNode* Node = Nodes.Find(Tile);
+	if (Node) {
+		Node->Rhs = Rhs;
+	} else if (Rhs < MAX_FLT) {
+		Nodes.Add(Tile).Rhs = Rhs;
+	}
+}
+
+void FTileNavIncrementalSearch::UpdateTile(const int32 Tile) {
+	FNode* Node = Nodes.Find(Tile);
+	if (!Node) {
+		return;
+	}
+	if (Node->G == Node->Rhs) {
+		Node->bOpen = false;
+		return;
+	}
+	Node->bOpen = true;
+	Node->Stamp = ++NextStamp;
+	FOpenEntry Entry = MakeEntry(Tile);
+	Entry.Stamp = Node->Stamp;
+	Open.HeapPush(Entry, FLowestKey());
+}
+
+bool FTileNavIncrementalSearch::ComputeShortestPath(FTileNavSearchStats& Stats) {
+	const double StartTime = FPlatformTime::Seconds();
+	const FTileNavGrid& TileGrid = *Grid;
+	while (Open.Num() > 0) {
+
+		// Entries are never removed from the heap, only superseded by a newer stamp or by the tile being closed
+		const FOpenEntry& Top = Open.HeapTop();
+		const FNode* TopNode = Nodes.Find(Top.Tile);
+		if (!TopNode || !TopNode->bOpen || TopNode->Stamp != Top.Stamp) {
+			Open.HeapPopDiscard(FLowestKey(), false);
+			continue;
+		}
+
+		// Done once the start agrees with its neighbors and no open tile could still lower its distance. First keys
+		// within rounding of the start's are treated as ties, since stopping early on a tie would keep a stale distance
+		const FOpenEntry StartEntry = MakeEntry(StartTile);
+		const float Tolerance = KINDA_SMALL_NUMBER * FMath::Max(StartEntry.Key1, 1.0f);
+		const bool bBeforeStart = Top.Key1 < StartEntry.Key1 - Tolerance || (Top.Key1 <= StartEntry.Key1 + Tolerance && Top.Key2 < StartEntry.Key2);
+		if (!bBeforeStart && GetG(StartTile) == GetRhs(StartTile)) {
+			break;
+		}
+		FOpenEntry Current;
+		Open.HeapPop(Current, FLowestKey(), false);
+
+		// Keys only grow as the start moves, so a tile opened before the move goes back in with its current key
+		if (FLowestKey()(Current, MakeEntry(Current.Tile))) {
+			UpdateTile(Current.Tile);
+			continue;
+		}
+		Stats.Expansions++;
+
+		FNode& Node = Nodes[Current.Tile];
+		Node.bOpen = false;
+		const uint8 Mask = TileGrid.NeighborMasks[Current.Tile];
+		if (Node.G > Node.Rhs) {
+
+			// Overconsistent. The tile's distance drops to its cheapest step, which may lower the tiles around it
+			Node.G = Node.Rhs;
+			const float G = Node.G;
+			for (int32 Direction = 0; Direction < 8; Direction++) {
+				const int32 NeighborTile = Current.Tile + TileGrid.NeighborOffsets[Direction];
+				if (!(Mask & (1 << Direction)) || NeighborTile == GoalTile) {
+					continue;
+				}
+				const float Cost = GetCost(NeighborTile, Current.Tile);
+				if (Cost < MAX_FLT && Cost + G < GetRhs(NeighborTile)) {
+					SetRhs(NeighborTile, Cost + G);
+					UpdateTile(NeighborTile);
+				}
+			}
+		} else {
+
+			// Underconsistent. The tile's distance is no longer supported, so it and every tile that stepped through
+			// it look for their cheapest step again. Rounding is allowed for when matching those tiles
+			const float OldG = Node.G;
+			Node.G = MAX_FLT;
+			for (int32 Direction = 0; Direction < 8; Direction++) {
+				const int32 NeighborTile = Current.Tile + TileGrid.NeighborOffsets[Direction];
+				if (!(Mask & (1 << Direction)) || NeighborTile == GoalTile) {
+					continue;
+				}
+				const float Cost = GetCost(NeighborTile, Current.Tile);
+				const float Rhs = GetRhs(NeighborTile);
+				if (Cost < MAX_FLT && Rhs < MAX_FLT && Cost + OldG <= Rhs + KINDA_SMALL_NUMBER * FMath::Max(Rhs, 1.0f)) {
+					SetRhs(NeighborTile, ComputeRhs(NeighborTile));
+					UpdateTile(NeighborTile);
+				}
+			}
+			UpdateTile(Current.Tile);
+		}
+	}
+	Stats.Milliseconds += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	return GetRhs(StartTile) < MAX_FLT;
+}
@@ -0,0 +1,7 @@
+#include "TileNavPath.h"
+
+const FNavPathType FTileNavPath::Type(&FNavigationPath::Type);
+
+FTileNavPath::FTileNavPath(): ClearanceRadius(0.0f) {
+	PathType = FTileNavPath::Type;
+}
@@ -0,0 +1,116 @@
+#include "TileNavPathCache.h"
+
+bool FTileNavPathCache::Find(const FTileNavPathCacheKey& Key, const TArray<uint32>& SectionGenerations, TArray<FVector>& PathTiles, TArray<int32>& PathSections, bool& bFound) {
+	FScopeLock ScopeLock(&Lock);
+	const int32* EntryIndex = EntryIndices.Find(Key);
+	if (!EntryIndex) {
+		Stats.Misses++;
+		return false;
+	}
+	const int32 Index = *EntryIndex;
+	FEntry& Entry = Entries[Index];
+	for (auto& SectionGeneration: Entry.SectionGenerations) {
+		if (!SectionGenerations.IsValidIndex(SectionGeneration.Key) || SectionGenerations[SectionGeneration.Key] != SectionGeneration.Value) {
+			Remove(Index);
+			Stats.Invalidations++;
+			Stats.Misses++;
+			return false;
+		}
+	}
+	PathTiles.Append(Entry.PathTiles);
+	for (auto& SectionGeneration: Entry.SectionGenerations) {
+		PathSections.Add(SectionGeneration.Key);
+	}
+	bFound = Entry.bFound;
+	Unlink(Index);
+	Link(Index);
+	Stats.Hits++;
+	return true;
+}
+
+void FTileNavPathCache::Add(
+	const FTileNavPathCacheKey& Key,
+	const TArray<uint32>& SectionGenerations,
+	const TArray<int32>& PathSections,
+	const TArray<FVector>& PathTiles,
+	const bool bFound,
+	const SIZE_T MaxBytes) {
+
+	FScopeLock ScopeLock(&Lock);
+	if (const int32* ExistingIndex = EntryIndices.Find(Key)) {
+		Remove(*ExistingIndex);
+	}
+	const SIZE_T Bytes = sizeof(FEntry) + PathTiles.Num() * sizeof(FVector) + PathSections.Num() * sizeof(TPair<int32, uint32>);
+	if (Bytes > MaxBytes) {
+		return;
+	}
+	while (Oldest != INDEX_NONE && Stats.Bytes + Bytes > MaxBytes) {
+		Remove(Oldest);
+		Stats.Evictions++;
+	}
+
+	const int32 Index = Entries.Add(FEntry(Key));
+	FEntry& Entry = Entries[Index];
+	Entry.PathTiles = PathTiles;
+	Entry.bFound = bFound;
+	Entry.Bytes = Bytes;
+	for (const int32 SectionIndex: PathSections) {
+		Entry.SectionGenerations.Add(TPair<int32, uint32>(SectionIndex, SectionGenerations.IsValidIndex(SectionIndex) ? SectionGenerations[SectionIndex] : 0));
+	}
+	EntryIndices.Add(Key, Index);
+	Link(Index);
+	Stats.Bytes += Bytes;
+	Stats.Entries++;
+}
+
+void FTileNavPathCache::Empty() {
+	FScopeLock ScopeLock(&Lock);
+	Entries.Empty();
+	EntryIndices.Empty();
+	Newest = INDEX_NONE;
+	Oldest = INDEX_NONE;
+	Stats.Entries = 0;
+	Stats.Bytes = 0;
+}
+
+FTileNavPathCacheStats FTileNavPathCache::GetStats() const {
+	FScopeLock ScopeLock(&Lock);
+	return Stats;
+}
+
+void FTileNavPathCache::Link(const int32 EntryIndex) {
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Newer = INDEX_NONE;
+	Entry.Older = Newest;
+	if (Newest != INDEX_NONE) {
+		Entries[Newest].Newer = EntryIndex;
+	}
+	Newest = EntryIndex;
+	if (Oldest == INDEX_NONE) {
+		Oldest = EntryIndex;
+	}
+}
+
+void FTileNavPathCache::Unlink(const int32 EntryIndex) {
+	FEntry& Entry = Entries[EntryIndex];
+	if (Entry.Newer != INDEX_NONE) {
+		Entries[Entry.Newer].Older = Entry.Older;
+	} else {
+		Newest = Entry.Older;
+	}
+	if (Entry.Older != INDEX_NONE) {
+		Entries[Entry.Older].Newer = Entry.Newer;
+	} else {
+		Oldest = Entry.Newer;
+	}
+	Entry.Newer = INDEX_NONE;
+	Entry.Older = INDEX_NONE;
+}
+
+void FTileNavPathCache::Remove(const int32 EntryIndex) {
+	Unlink(EntryIndex);
+	Stats.Bytes -= Entries[EntryIndex].Bytes;
+	Stats.Entries--;
+	EntryIndices.Remove(Entries[EntryIndex].Key);
+	Entries.RemoveAt(EntryIndex);
+}
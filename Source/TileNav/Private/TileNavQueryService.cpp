@@ -0,0 +1,106 @@
+#include "TileNavQueryService.h"
+
+FTileNavQueryService::FTileNavQueryService(): BatchStartTime(0.0), BatchWorkers(0), NextQueryID(0) {
+}
+
+FTileNavQueryService::~FTileNavQueryService() {
+	Flush();
+}
+
+uint32 FTileNavQueryService::Enqueue(const FPathFindingQuery& Query, const FNavPathQueryDelegate& ResultDelegate) {
+	check(IsInGameThread());
+
+	// Zero is reserved as an invalid query ID
+	if (++NextQueryID == 0) {
+		NextQueryID++;
+	}
+	FQuery& PendingQuery = PendingQueries.AddDefaulted_GetRef();
+	PendingQuery.QueryID = NextQueryID;
+	PendingQuery.Query = Query;
+	PendingQuery.ResultDelegate = ResultDelegate;
+	return NextQueryID;
+}
+
+void FTileNavQueryService::Abort(const uint32 QueryID) {
+	check(IsInGameThread());
+	const int32 PendingIndex = PendingQueries.IndexOfByPredicate([QueryID](const FQuery& Query) {
+		return Query.QueryID == QueryID;
+	});
+	if (PendingIndex != INDEX_NONE) {
+		PendingQueries.RemoveAt(PendingIndex);
+	} else if (InFlightQueries.ContainsByPredicate([QueryID](const FQuery& Query) { return Query.QueryID == QueryID; })) {
+		AbortedQueries.Add(QueryID);
+	}
+}
+
+void FTileNavQueryService::Tick(const int32 NumWorkers, const bool bLogThroughput) {
+	check(IsInGameThread());
+	if (IsBusy()) {
+		for (auto& Task: InFlightTasks) {
+			if (!Task->IsComplete()) {
+				return;
+			}
+		}
+		DeliverResults(bLogThroughput);
+	}
+	if (PendingQueries.Num() > 0) {
+		DispatchPending(NumWorkers);
+	}
+}
+
+void FTileNavQueryService::Flush() {
+	if (InFlightTasks.Num() > 0) {
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(InFlightTasks);
+	}
+	InFlightTasks.Empty();
+	InFlightQueries.Empty();
+	PendingQueries.Empty();
+	AbortedQueries.Empty();
+}
+
+void FTileNavQueryService::DeliverResults(const bool bLogThroughput) {
+	if (bLogThroughput) {
+		const double Seconds = FPlatformTime::Seconds() - BatchStartTime;
+		UE_LOG(LogNavigation, Display, TEXT("TileNav async batch: %d queries on %d workers in %.2f ms (%.0f queries/sec)"),
+			InFlightQueries.Num(), BatchWorkers, Seconds * 1000.0, Seconds > 0.0 ? InFlightQueries.Num() / Seconds : 0.0);
+	}
+
+	// Delegates may queue further queries, so deliver from a local copy of the batch
+	TArray<FQuery> Completed = MoveTemp(InFlightQueries);
+	TSet<uint32> Aborted = MoveTemp(AbortedQueries);
+	InFlightQueries.Reset();
+	InFlightTasks.Reset();
+	AbortedQueries.Reset();
+	for (auto& Query: Completed) {
+		if (!Aborted.Contains(Query.QueryID)) {
+			Query.ResultDelegate.ExecuteIfBound(Query.QueryID, Query.Result.Result, Query.Result.Path);
+		}
+	}
+}
+
+void FTileNavQueryService::DispatchPending(const int32 NumWorkers) {
+	InFlightQueries = MoveTemp(PendingQueries);
+	PendingQueries.Reset();
+	BatchStartTime = FPlatformTime::Seconds();
+
+	const int32 AvailableWorkers = FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads(), 1);
+	BatchWorkers = FMath::Clamp(NumWorkers > 0 ? NumWorkers : AvailableWorkers, 1, InFlightQueries.Num());
+
+	// Split the batch into contiguous chunks, one task per worker. Each task only writes the results of its own chunk
+	const int32 ChunkSize = FMath::DivideAndRoundUp(InFlightQueries.Num(), BatchWorkers);
+	FQuery* Queries = InFlightQueries.GetData();
+	for (int32 ChunkStart = 0; ChunkStart < InFlightQueries.Num(); ChunkStart += ChunkSize) {
+		const int32 ChunkEnd = FMath::Min(ChunkStart + ChunkSize, InFlightQueries.Num());
+		InFlightTasks.Add(FFunctionGraphTask::CreateAndDispatchWhenReady([Queries, ChunkStart, ChunkEnd]() {
+			for (int32 Index = ChunkStart; Index < ChunkEnd; Index++) {
+				FQuery& Query = Queries[Index];
+				const ANavigationData* NavData = Query.Query.NavData.Get();
+				if (NavData) {
+					Query.Result = NavData->FindPath(Query.Query.NavAgentProperties, Query.Query);
+				} else {
+					Query.Result = FPathFindingResult(ENavigationQueryResult::Error);
+				}
+			}
+		}, TStatId(), nullptr, ENamedThreads::AnyBackgroundThreadNormalTask));
+	}
+}
@@ -0,0 +1,54 @@
+#include "TileNavReachability.h"
+
+void FTileNavReachability::Build(const TArray<TSharedPtr<const FTileNavGrid, ESPMode::ThreadSafe>>& Grids) {
+	FirstRegions.Reset();
+	Components.Reset();
+	for (auto& Grid: Grids) {
+		FirstRegions.Add(Components.Num());
+		if (Grid.IsValid()) {
+			for (int32 Region = 0; Region < Grid->RegionSizes.Num(); Region++) {
+				Components.Add(Components.Num());
+			}
+		}
+	}
+	const auto FindRoot = [this](int32 Index) {
+		while (Components[Index] != Index) {
+			Components[Index] = Components[Components[Index]];
+			Index = Components[Index];
+		}
+		return Index;
+	};
+
+	// Portal searches cross from a portal to the nearest portal back, so joining a portal's region with the region of
+	// every portal back never separates regions that a search could connect
+	for (int32 Section = 0; Section < Grids.Num(); Section++) {
+		const FTileNavGrid* Grid = Grids[Section].Get();
+		if (!Grid) {
+			continue;
+		}
+		for (auto& Portal: Grid->Portals) {
+			const FTileNavGrid* TargetGrid = Grids.IsValidIndex(Portal.TargetSection) ? Grids[Portal.TargetSection].Get() : nullptr;
+			const int32 Region = Grid->GetRegion(Portal.TileIndex);
+			if (!TargetGrid || Region == INDEX_NONE) {
+				continue;
+			}
+			for (auto& TargetPortal: TargetGrid->Portals) {
+				const int32 TargetRegion = TargetGrid->GetRegion(TargetPortal.TileIndex);
+				if (TargetPortal.TargetSection == Section && TargetRegion != INDEX_NONE) {
+					const int32 Root = FindRoot(FirstRegions[Section] + Region);
+					const int32 TargetRoot = FindRoot(FirstRegions[Portal.TargetSection] + TargetRegion);
+					if (Root != TargetRoot) {
+						Components[TargetRoot] = Root;
+					}
+				}
+			}
+		}
+	}
+	for (int32 Index = 0; Index < Components.Num(); Index++) {
+		Components[Index] = FindRoot(Index);
+	}
+}
+
+SIZE_T FTileNavReachability::GetAllocatedSize() const {
+	return FirstRegions.GetAllocatedSize() + Components.GetAllocatedSize();
+}
@@ -0,0 +1,27 @@
+#include "TileNavSearchState.h"
+
+TileNavSearch::FSearchState& TileNavSearch::GetThreadSearchState(const int32 Slot) {
+	check(Slot >= 0 && Slot < NumThreadSearchStates);
+	static thread_local FSearchState SearchStates[NumThreadSearchStates];
+	return SearchStates[Slot];
+}
+
+TileNavSearch::FSearchStatePool::FSearchStatePool(const int32 InMaxStates): NumLent(0), MaxStates(InMaxStates) {
+}
+
+TUniquePtr<TileNavSearch::FSearchState> TileNavSearch::FSearchStatePool::Acquire(const int32 NumTiles) {
+	if (NumLent >= MaxStates) {
+		return nullptr;
+	}
+	TUniquePtr<FSearchState> State = FreeStates.Num() > 0 ? FreeStates.Pop(false) : MakeUnique<FSearchState>();
+	State->Reset(NumTiles);
+	NumLent++;
+	return State;
+}
+
+void TileNavSearch::FSearchStatePool::Release(TUniquePtr<FSearchState>&& State) {
+	if (State.IsValid()) {
+		FreeStates.Add(MoveTemp(State));
+		NumLent--;
+	}
+}
@@ -0,0 +1,157 @@
+#include "TileNavSectionRoutes.h"
+#include "Async/ParallelFor.h"
+
+namespace TileNavSectionRouting {
+	struct FOpenSection {
+		int32 Section;
+		float Distance;
+	};
+
+	struct FNearest {
+		FORCEINLINE bool operator()(const FOpenSection& A, const FOpenSection& B) const {
+			return A.Distance < B.Distance;
+		}
+	};
+
+	float FindCost(const TArray<FTileNavSectionLink>& SectionLinks, const int32 To) {
+		const FTileNavSectionLink* Link = SectionLinks.FindByPredicate([To](const FTileNavSectionLink& Candidate) {
+			return Candidate.Section == To;
+		});
+		return Link ? Link->Cost : MAX_FLT;
+	}
+}
+
+int32 FTileNavSectionRoutes::Update(TArray<TArray<FTileNavSectionLink>>&& NewLinks, const bool bParallel) {
+	using namespace TileNavSectionRouting;
+
+	const int32 OldNum = NumSections;
+	const int32 NewNum = NewLinks.Num();
+	TArray<bool> AffectedGoals;
+	AffectedGoals.Init(NewNum < OldNum, NewNum);
+
+	// Keep the routes between existing sections. New sections start unreachable, so any link they add is picked up
+	// below as a shortcut, and their own goals are always computed
+	if (NewNum != OldNum) {
+		TArray<int32> OldNextHops = MoveTemp(NextHops);
+		TArray<float> OldDistances = MoveTemp(Distances);
+		NextHops.Init(INDEX_NONE, NewNum * NewNum);
+		Distances.Init(MAX_FLT, NewNum * NewNum);
+		const int32 KeptNum = FMath::Min(OldNum, NewNum);
+		for (int32 Goal = 0; Goal < KeptNum; Goal++) {
+			FMemory::Memcpy(&NextHops[Goal * NewNum], &OldNextHops[Goal * OldNum], KeptNum * sizeof(int32));
+			FMemory::Memcpy(&Distances[Goal * NewNum], &OldDistances[Goal * OldNum], KeptNum * sizeof(float));
+		}
+		for (int32 Goal = KeptNum; Goal < NewNum; Goal++) {
+			AffectedGoals[Goal] = true;
+		}
+		NumSections = NewNum;
+	}
+	Links.SetNum(NewNum);
+
+	for (int32 From = 0; From < NewNum; From++) {
+
+		// A dearer or removed link only matters to the goals whose tree goes through it
+		for (auto& OldLink: Links[From]) {
+			if (FindCost(NewLinks[From], OldLink.Section) <= OldLink.Cost) {
+				continue;
+			}
+			for (int32 Goal = 0; Goal < NewNum; Goal++) {
+				if (NextHops[Goal * NewNum + From] == OldLink.Section) {
+					AffectedGoals[Goal] = true;
+				}
+			}
+		}
+
+		// A new or cheaper link only matters to the goals it gives a shorter route to
+		for (auto& NewLink: NewLinks[From]) {
+			if (NewLink.Cost >= FindCost(Links[From], NewLink.Section)) {
+				continue;
+			}
+			for (int32 Goal = 0; Goal < NewNum; Goal++) {
+				const float Distance = Distances[Goal * NewNum + NewLink.Section];
+				if (Distance != MAX_FLT && NewLink.Cost + Distance < Distances[Goal * NewNum + From]) {
+					AffectedGoals[Goal] = true;
+				}
+			}
+		}
+	}
+
+	Links = MoveTemp(NewLinks);
+	ReverseLinks.Reset();
+	ReverseLinks.SetNum(NewNum);
+	for (int32 From = 0; From < NewNum; From++) {
+		for (auto& Link: Links[From]) {
+			ReverseLinks[Link.Section].Add(FTileNavSectionLink(From, Link.Cost));
+		}
+	}
+
+	// Each goal only writes its own routes, so they are recomputed in parallel
+	TArray<int32> Goals;
+	for (int32 Goal = 0; Goal < NewNum; Goal++) {
+		if (AffectedGoals[Goal]) {
+			Goals.Add(Goal);
+		}
+	}
+	ParallelFor(Goals.Num(), [this, &Goals](const int32 Index) {
+		BuildGoal(Goals[Index]);
+	}, !bParallel);
+	return Goals.Num();
+}
+
+bool FTileNavSectionRoutes::FindRoute(const int32 Start, const int32 Goal, TArray<int32>& OutRoute) const {
+	OutRoute.Reset();
+	if (Start < 0 || Goal < 0 || Start >= NumSections || Goal >= NumSections || GetDistance(Start, Goal) == MAX_FLT) {
+		return false;
+	}
+	OutRoute.Add(Start);
+	int32 Section = Start;
+	while (Section != Goal) {
+		Section = NextHops[Goal * NumSections + Section];
+		if (Section == INDEX_NONE || OutRoute.Num() > NumSections) {
+			OutRoute.Reset();
+			return false;
+		}
+		OutRoute.Add(Section);
+	}
+	return true;
+}
+
+SIZE_T FTileNavSectionRoutes::GetAllocatedSize() const {
+	SIZE_T Size = Links.GetAllocatedSize() + ReverseLinks.GetAllocatedSize() + NextHops.GetAllocatedSize() + Distances.GetAllocatedSize();
+	for (int32 Section = 0; Section < NumSections; Section++) {
+		Size += Links[Section].GetAllocatedSize() + ReverseLinks[Section].GetAllocatedSize();
+	}
+	return Size;
+}
+
+void FTileNavSectionRoutes::BuildGoal(const int32 Goal) {
+	using namespace TileNavSectionRouting;
+
+	// Dijkstra outward from the goal along links into each section, recording the step back towards the goal
+	int32* GoalNextHops = &NextHops[Goal * NumSections];
+	float* GoalDistances = &Distances[Goal * NumSections];
+	for (int32 Section = 0; Section < NumSections; Section++) {
+		GoalNextHops[Section] = INDEX_NONE;
+		GoalDistances[Section] = MAX_FLT;
+	}
+	GoalNextHops[Goal] = Goal;
+	GoalDistances[Goal] = 0.0f;
+
+	TArray<FOpenSection> Open;
+	Open.HeapPush(FOpenSection{Goal, 0.0f}, FNearest());
+	while (Open.Num() > 0) {
+		FOpenSection Current;
+		Open.HeapPop(Current, FNearest(), false);
+		if (Current.Distance > GoalDistances[Current.Section]) {
+			continue;
+		}
+		for (auto& Link: ReverseLinks[Current.Section]) {
+			const float Distance = Current.Distance + Link.Cost;
+			if (Distance < GoalDistances[Link.Section]) {
+				GoalDistances[Link.Section] = Distance;
+				GoalNextHops[Link.Section] = Current.Section;
+				Open.HeapPush(FOpenSection{Link.Section, Distance}, FNearest());
+			}
+		}
+	}
+}
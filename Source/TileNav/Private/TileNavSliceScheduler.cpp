@@ -0,0 +1,108 @@
+#include "TileNavSliceScheduler.h"
+
+FTileNavSliceScheduler::FTileNavSliceScheduler(): NextQueryID(0), SearchStates(MaxSearchStates) {
+}
+
+uint32 FTileNavSliceScheduler::Enqueue(const FTileNavSlicedRequest& Request) {
+	check(IsInGameThread());
+
+	// Zero is reserved as an invalid query ID
+	if (++NextQueryID == 0) {
+		NextQueryID++;
+	}
+	FTileNavSlicedRequest& PendingRequest = Requests.Add_GetRef(Request);
+	PendingRequest.QueryID = NextQueryID;
+	PendingRequest.Age = 0;
+	return NextQueryID;
+}
+
+void FTileNavSliceScheduler::Abort(const uint32 QueryID) {
+	check(IsInGameThread());
+	Requests.RemoveAll([this, QueryID](const FTileNavSlicedRequest& Request) {
+		if (Request.QueryID != QueryID) {
+			return false;
+		}
+		Request.Query->ReleaseSearchState(SearchStates);
+		return true;
+	});
+}
+
+void FTileNavSliceScheduler::Tick(
+	const double BudgetSeconds,
+	const int32 MaxExpansions,
+	TArray<FTileNavSlicedRequest>& OutFinished,
+	TArray<FTileNavSlicedRequest>& OutAdvanced,
+	FTileNavSearchStats& Stats) {
+
+	check(IsInGameThread());
+	if (Requests.Num() == 0) {
+		return;
+	}
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 StartExpansions = Stats.Expansions;
+
+	// Stable, so that requests of equal standing are served in the order they arrived
+	Requests.StableSort([](const FTileNavSlicedRequest& A, const FTileNavSlicedRequest& B) {
+		return A.Priority + A.Age > B.Priority + B.Age;
+	});
+	TBitArray<> Served(false, Requests.Num());
+	const auto IsOverBudget = [&]() {
+		return (BudgetSeconds > 0.0 && FPlatformTime::Seconds() - StartTime >= BudgetSeconds) ||
+			(MaxExpansions > 0 && Stats.Expansions - StartExpansions >= MaxExpansions);
+	};
+	bool bPending = true;
+	while (bPending && !IsOverBudget()) {
+		bPending = false;
+		for (int32 Index = 0; Index < Requests.Num() && !IsOverBudget(); Index++) {
+			FTileNavSlicedQuery& Query = *Requests[Index].Query;
+			if (Query.IsDone()) {
+				continue;
+			}
+			const int32 Slice = MaxExpansions > 0 ? FMath::Min(SliceExpansions, MaxExpansions - (Stats.Expansions - StartExpansions)) : SliceExpansions;
+			const int32 SliceStartExpansions = Stats.Expansions;
+			Query.Step(Slice, Stats, SearchStates);
+
+			// A query that spent nothing is waiting for a search state, and is not served until one is released
+			if (Query.IsDone() || Stats.Expansions > SliceStartExpansions) {
+				Served[Index] = true;
+				bPending |= !Query.IsDone();
+			}
+		}
+	}
+	Stats.Milliseconds += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	// Queries that already failed when queued are reported on the first tick, without needing a slice
+	const int32 FirstFinished = OutFinished.Num();
+	int32 NumPending = 0;
+	for (int32 Index = 0; Index < Requests.Num(); Index++) {
+		FTileNavSlicedRequest& Request = Requests[Index];
+		if (Request.Query->IsDone()) {
+			OutFinished.Add(MoveTemp(Request));
+			continue;
+		}
+		if (Served[Index]) {
+			Request.Age = 0;
+			OutAdvanced.Add(Request);
+		} else {
+			Request.Age++;
+		}
+		if (NumPending != Index) {
+			Requests[NumPending] = MoveTemp(Request);
+		}
+		NumPending++;
+	}
+	Requests.SetNum(NumPending, false);
+
+	// Requests are served by priority but finish in the order they were queued. IDs are compared by their difference
+	// so that the order holds when they wrap around
+	MakeArrayView(OutFinished.GetData() + FirstFinished, OutFinished.Num() - FirstFinished).StableSort([](const FTileNavSlicedRequest& A, const FTileNavSlicedRequest& B) {
+		return static_cast<int32>(A.QueryID - B.QueryID) < 0;
+	});
+}
+
+void FTileNavSliceScheduler::Empty() {
+	for (const FTileNavSlicedRequest& Request: Requests) {
+		Request.Query->ReleaseSearchState(SearchStates);
+	}
+	Requests.Empty();
+}
@@ -0,0 +1,163 @@
+#include "TileNavSlicedSearch.h"
+
+FTileNavSlicedSearch::FTileNavSlicedSearch(
+	const FTileNavGridConstPtr& InGrid,
+	const int32 InStartTile,
+	const int32 InEndTile,
+	const uint8 InMinClearance,
+	TUniquePtr<TileNavSearch::FSearchState>&& InSearch):
+	Grid(InGrid), StartTile(InStartTile), EndTile(InEndTile), MinClearance(InMinClearance), Status(ETileNavSearchStatus::InProgress),
+	Search(MoveTemp(InSearch)), NearestTile(InStartTile), NearestDistance(MAX_FLT) {
+
+	if (!Search.IsValid() || !Grid.IsValid() || !Grid->IsValidTile(StartTile) || !Grid->IsValidTile(EndTile)) {
+		Status = ETileNavSearchStatus::Failed;
+		NearestTile = INDEX_NONE;
+		return;
+	}
+	Search->Open(StartTile, INDEX_NONE, 0.0f, Grid->GetHeuristic(StartTile, EndTile));
+}
+
+ETileNavSearchStatus FTileNavSlicedSearch::Step(const int32 MaxExpansions, FTileNavSearchStats& Stats) {
+	if (Status != ETileNavSearchStatus::InProgress || !Search.IsValid()) {
+		return Status;
+	}
+	const double StartTime = FPlatformTime::Seconds();
+	const FTileNavGrid& TileGrid = *Grid;
+	TileNavSearch::FSearchState& SearchState = *Search;
+	FPathTile CurrentPathTile;
+	for (int32 Expansion = 0; Expansion < MaxExpansions; Expansion++) {
+		if (!SearchState.PopBest(CurrentPathTile)) {
+			Status = ETileNavSearchStatus::Failed;
+			break;
+		}
+		Stats.Expansions++;
+		if (CurrentPathTile.H < NearestDistance) {
+			NearestDistance = CurrentPathTile.H;
+			NearestTile = CurrentPathTile.Index;
+		}
+		if (CurrentPathTile.Index == EndTile) {
+			Status = ETileNavSearchStatus::Succeeded;
+			break;
+		}
+
+		const FVector& CurrentLocation = TileGrid.Locations[CurrentPathTile.Index];
+		const uint8 Mask = TileGrid.NeighborMasks[CurrentPathTile.Index];
+		for (int32 Direction = 0; Direction < 8; Direction++) {
+			if (!(Mask & (1 << Direction))) {
+				continue;
+			}
+			const int32 ChildIndex = CurrentPathTile.Index + TileGrid.NeighborOffsets[Direction];
+			if (!TileGrid.IsWalkable(ChildIndex, MinClearance)) {
+				continue;
+			}
+			SearchState.Open(
+				ChildIndex,
+				CurrentPathTile.Index,
+				CurrentPathTile.G + FVector::Distance(TileGrid.Locations[ChildIndex], CurrentLocation),
+				TileGrid.GetHeuristic(ChildIndex, EndTile)
+			);
+		}
+	}
+	Stats.Milliseconds += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	return Status;
+}
+
+bool FTileNavSlicedSearch::AppendPath(TArray<int32>& OutPath) const {
+	if (NearestTile == INDEX_NONE || !Search.IsValid()) {
+		return false;
+	}
+	if (Status == ETileNavSearchStatus::Succeeded) {
+		Search->AppendPath(EndTile, OutPath);
+		return true;
+	}
+	Search->AppendPath(NearestTile, OutPath);
+	return false;
+}
+
+TUniquePtr<TileNavSearch::FSearchState> FTileNavSlicedSearch::ReleaseSearchState() {
+	return MoveTemp(Search);
+}
+
+FTileNavSlicedQuery::FTileNavSlicedQuery(
+	const FTileNavSnapshotPtr& InSnapshot,
+	const TArray<FTileNavSearchLeg>& InLegs,
+	const TArray<int32>& InPathSections,
+	const float InClearanceRadius):
+	Snapshot(InSnapshot), Legs(InLegs), PathSections(InPathSections), ClearanceRadius(InClearanceRadius),
+	Status(ETileNavSearchStatus::InProgress), LegIndex(0) {
+
+	if (!Snapshot.IsValid() || Legs.Num() == 0) {
+		Status = ETileNavSearchStatus::Failed;
+	}
+}
+
+ETileNavSearchStatus FTileNavSlicedQuery::Step(const int32 MaxExpansions, FTileNavSearchStats& Stats, TileNavSearch::FSearchStatePool& SearchStates) {
+	const int32 StartExpansions = Stats.Expansions;
+	while (Status == ETileNavSearchStatus::InProgress && Stats.Expansions - StartExpansions < MaxExpansions) {
+		const FTileNavSearchLeg& Leg = Legs[LegIndex];
+		const FTileNavGridConstPtr& LegGrid = Snapshot->Grids.IsValidIndex(Leg.Section) ? Snapshot->Grids[Leg.Section] : nullptr;
+		if (!LegGrid.IsValid()) {
+			Status = ETileNavSearchStatus::Failed;
+			break;
+		}
+
+		// Steps across a link need no search
+		TArray<int32> LegTiles;
+		if (Leg.StartTile == Leg.EndTile) {
+			LegTiles.Add(Leg.EndTile);
+		} else {
+			if (!LegSearch.IsValid()) {
+				TUniquePtr<TileNavSearch::FSearchState> SearchState = SearchStates.Acquire(LegGrid->Num());
+				if (!SearchState.IsValid()) {
+					break;
+				}
+				LegSearch = MakeUnique<FTileNavSlicedSearch>(LegGrid, Leg.StartTile, Leg.EndTile, LegGrid->GetClearanceLevel(ClearanceRadius), MoveTemp(SearchState));
+			}
+			const ETileNavSearchStatus LegStatus = LegSearch->Step(MaxExpansions - (Stats.Expansions - StartExpansions), Stats);
+			if (LegStatus == ETileNavSearchStatus::InProgress) {
+				break;
+			}
+
+			// Only the leg's path is kept once it is over, so its state can go to the next search straight away
+			LegSearch->AppendPath(LegTiles);
+			ReleaseSearchState(SearchStates);
+			if (LegStatus == ETileNavSearchStatus::Failed) {
+
+				// The partial path of the failed leg stays available, as far as it got towards the leg's end
+				AppendTiles(*LegGrid, LegTiles, PathTiles);
+				Status = ETileNavSearchStatus::Failed;
+				break;
+			}
+		}
+		AppendTiles(*LegGrid, LegTiles, PathTiles);
+		if (++LegIndex == Legs.Num()) {
+			Status = ETileNavSearchStatus::Succeeded;
+		}
+	}
+	return Status;
+}
+
+void FTileNavSlicedQuery::ReleaseSearchState(TileNavSearch::FSearchStatePool& SearchStates) {
+	if (LegSearch.IsValid()) {
+		SearchStates.Release(LegSearch->ReleaseSearchState());
+		LegSearch.Reset();
+	}
+}
+
+bool FTileNavSlicedQuery::GetPath(TArray<FVector>& OutPathTiles) const {
+	OutPathTiles = PathTiles;
+	if (LegSearch.IsValid() && Legs.IsValidIndex(LegIndex)) {
+		TArray<int32> LegTiles;
+		LegSearch->AppendPath(LegTiles);
+		AppendTiles(*Snapshot->GetGrid(Legs[LegIndex].Section), LegTiles, OutPathTiles);
+	}
+	return Status == ETileNavSearchStatus::Succeeded;
+}
+
+void FTileNavSlicedQuery::AppendTiles(const FTileNavGrid& LegGrid, const TArray<int32>& LegTiles, TArray<FVector>& OutPathTiles) const {
+	for (const int32 TileIndex: LegTiles) {
+		if (OutPathTiles.Num() == 0 || OutPathTiles.Last() != LegGrid.Locations[TileIndex]) {
+			OutPathTiles.Add(LegGrid.Locations[TileIndex]);
+		}
+	}
+}
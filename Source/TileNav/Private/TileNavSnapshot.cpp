@@ -0,0 +1,238 @@
+#include "TileNavSnapshot.h"
+
+bool FTileNavSnapshot::FindNearestTile(const FVector& Location, const float Radius, int32& OutSectionIndex, int32& OutTileIndex, const float ClearanceRadius) const {
+	OutSectionIndex = INDEX_NONE;
+	OutTileIndex = INDEX_NONE;
+	if (!SectionBounds.IsValid()) {
+		return false;
+	}
+
+	// Candidates are in ascending section order, so equidistant tiles resolve to the lowest section
+	TArray<int32> Candidates;
+	SectionBounds->Query(FBox(Location - FVector(Radius), Location + FVector(Radius)), Candidates);
+	float NearestDistance = MAX_FLT;
+	for (const int32 SectionIndex: Candidates) {
+		const FTileNavGrid* Grid = GetGrid(SectionIndex);
+		const int32 TileIndex = Grid ? Grid->FindNearestWalkableTile(Location, Grid->GetClearanceLevel(ClearanceRadius)) : INDEX_NONE;
+		if (TileIndex == INDEX_NONE) {
+			continue;
+		}
+		const float Distance = FVector::DistSquared(Location, Grid->Locations[TileIndex]);
+		if (Distance < NearestDistance) {
+			NearestDistance = Distance;
+			OutSectionIndex = SectionIndex;
+			OutTileIndex = TileIndex;
+		}
+	}
+	return OutSectionIndex != INDEX_NONE;
+}
+
+bool FTileNavSnapshot::IsReachable(const int32 StartSection, const int32 StartTile, const int32 EndSection, const int32 EndTile) const {
+	const FTileNavGrid* StartGrid = GetGrid(StartSection);
+	const FTileNavGrid* EndGrid = GetGrid(EndSection);
+	if (!StartGrid || !EndGrid) {
+		return false;
+	}
+	if (StartSection == EndSection) {
+		return StartGrid->CanReach(StartTile, EndTile);
+	}
+	const int32 StartComponent = Reachability.IsValid() ? Reachability->GetComponent(StartSection, StartGrid->GetRegion(StartTile)) : INDEX_NONE;
+	const int32 EndComponent = Reachability.IsValid() ? Reachability->GetComponent(EndSection, EndGrid->GetRegion(EndTile)) : INDEX_NONE;
+	return StartComponent != INDEX_NONE && StartComponent == EndComponent;
+}
+
+namespace TileNavPortalSearch {
+
+	// Portal graph nodes are keyed by section index in the upper half and portal index in the lower half. The goal
+	// is a single virtual node reached from every portal of the end section
+	const uint64 GoalKey = MAX_uint64;
+	const uint64 NoParent = MAX_uint64 - 1;
+
+	FORCEINLINE uint64 MakeKey(const int32 SectionIndex, const int32 PortalIndex) {
+		return (static_cast<uint64>(static_cast<uint32>(SectionIndex)) << 32) | static_cast<uint32>(PortalIndex);
+	}
+
+	struct FNode {
+		float G;
+		uint64 Parent;
+		bool bClosed;
+	};
+
+	struct FOpenNode {
+		uint64 Key;
+		float G;
+		float F;
+	};
+
+	struct FLowestF {
+		bool operator()(const FOpenNode& A, const FOpenNode& B) const {
+			return A.F < B.F;
+		}
+	};
+}
+
+bool FTileNavSnapshot::FindPortalRoute(
+	const int32 StartSection,
+	const int32 StartTile,
+	const int32 EndSection,
+	const int32 EndTile,
+	TArray<FTileNavSearchLeg>& OutLegs,
+	TArray<int32>& PathSections,
+	FTileNavSearchStats& Stats,
+	const float ClearanceRadius) const {
+
+	using namespace TileNavPortalSearch;
+	const FTileNavGrid* StartGrid = GetGrid(StartSection);
+	const FTileNavGrid* EndGrid = GetGrid(EndSection);
+	if (!StartGrid || !EndGrid) {
+		return false;
+	}
+
+	// The endpoint sections are the only ones searched tile by tile before the route is known
+	TArray<float> StartCosts;
+	TArray<float> EndCosts;
+	StartGrid->ComputePortalDistances(StartTile, StartCosts, Stats, StartGrid->GetClearanceLevel(ClearanceRadius));
+	EndGrid->ComputePortalDistances(EndTile, EndCosts, Stats, EndGrid->GetClearanceLevel(ClearanceRadius));
+	const FVector& EndLocation = EndGrid->Locations[EndTile];
+
+	const double StartTime = FPlatformTime::Seconds();
+	TMap<uint64, FNode> Nodes;
+	TArray<FOpenNode> OpenHeap;
+	const auto Open = [&Nodes, &OpenHeap, &EndLocation](const uint64 Key, const uint64 Parent, const float G, const FVector& Location) {
+		FNode* Node = Nodes.Find(Key);
+		if (Node && (Node->bClosed || G >= Node->G)) {
+			return;
+		}
+		if (!Node) {
+			Node = &Nodes.Add(Key);
+		}
+		Node->G = G;
+		Node->Parent = Parent;
+		Node->bClosed = false;
+		OpenHeap.HeapPush(FOpenNode{Key, G, G + FVector::Distance(Location, EndLocation)}, FLowestF());
+	};
+	for (int32 Portal = 0; Portal < StartCosts.Num(); Portal++) {
+		if (StartCosts[Portal] < MAX_FLT) {
+			Open(MakeKey(StartSection, Portal), NoParent, StartCosts[Portal], StartGrid->Locations[StartGrid->Portals[Portal].TileIndex]);
+		}
+	}
+
+	bool bRouteFound = false;
+	FOpenNode Current;
+	while (OpenHeap.Num() > 0) {
+		OpenHeap.HeapPop(Current, FLowestF(), false);
+		FNode& CurrentNode = Nodes[Current.Key];
+		if (CurrentNode.bClosed || Current.G > CurrentNode.G) {
+			continue;
+		}
+		CurrentNode.bClosed = true;
+		Stats.Expansions++;
+		if (Current.Key == GoalKey) {
+			bRouteFound = true;
+			break;
+		}
+
+		const int32 SectionIndex = static_cast<int32>(Current.Key >> 32);
+		const int32 PortalIndex = static_cast<int32>(Current.Key & MAX_uint32);
+		const FTileNavGrid& Grid = *GetGrid(SectionIndex);
+		const FTileNavPortal& Portal = Grid.Portals[PortalIndex];
+		const FVector& PortalLocation = Grid.Locations[Portal.TileIndex];
+		if (SectionIndex == EndSection && EndCosts[PortalIndex] < MAX_FLT) {
+			Open(GoalKey, Current.Key, Current.G + EndCosts[PortalIndex], EndLocation);
+		}
+
+		// Cross to another portal of the same section
+		for (int32 OtherPortal = 0; OtherPortal < Grid.Portals.Num(); OtherPortal++) {
+			const float Cost = Grid.GetPortalCost(PortalIndex, OtherPortal);
+			if (OtherPortal != PortalIndex && Cost < MAX_FLT) {
+				Open(MakeKey(SectionIndex, OtherPortal), Current.Key, Current.G + Cost, Grid.Locations[Grid.Portals[OtherPortal].TileIndex]);
+			}
+		}
+
+		// Step into the linked section through its nearest portal back into this one
+		const FTileNavGrid* TargetGrid = GetGrid(Portal.TargetSection);
+		if (!TargetGrid) {
+			continue;
+		}
+		int32 TargetPortal = INDEX_NONE;
+		float TargetDistance = MAX_FLT;
+		for (int32 OtherPortal = 0; OtherPortal < TargetGrid->Portals.Num(); OtherPortal++) {
+			if (TargetGrid->Portals[OtherPortal].TargetSection == SectionIndex) {
+				const float Distance = FVector::DistSquared(PortalLocation, TargetGrid->Locations[TargetGrid->Portals[OtherPortal].TileIndex]);
+				if (Distance < TargetDistance) {
+					TargetDistance = Distance;
+					TargetPortal = OtherPortal;
+				}
+			}
+		}
+		if (TargetPortal != INDEX_NONE) {
+			Open(MakeKey(Portal.TargetSection, TargetPortal), Current.Key, Current.G + FMath::Sqrt(TargetDistance),
+				TargetGrid->Locations[TargetGrid->Portals[TargetPortal].TileIndex]);
+		}
+	}
+	Stats.Milliseconds += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	if (!bRouteFound) {
+		return false;
+	}
+
+	// Walk back from the goal to list the portals in route order
+	TArray<uint64> Route;
+	for (uint64 Key = Nodes[GoalKey].Parent; Key != NoParent; Key = Nodes[Key].Parent) {
+		Route.Insert(Key, 0);
+	}
+	const auto GetSection = [](const uint64 Key) { return static_cast<int32>(Key >> 32); };
+	PathSections.AddUnique(StartSection);
+	for (const uint64 Key: Route) {
+		PathSections.AddUnique(GetSection(Key));
+	}
+	PathSections.AddUnique(EndSection);
+
+	// Legs run between portals of the same section. Steps between sections go straight from portal to portal
+	const auto GetPortalTile = [this](const uint64 Key) {
+		return GetGrid(static_cast<int32>(Key >> 32))->Portals[static_cast<int32>(Key & MAX_uint32)].TileIndex;
+	};
+	OutLegs.Add(FTileNavSearchLeg(StartSection, StartTile, GetPortalTile(Route[0])));
+	for (int32 Index = 1; Index < Route.Num(); Index++) {
+		const int32 FromTile = GetSection(Route[Index - 1]) == GetSection(Route[Index]) ? GetPortalTile(Route[Index - 1]) : GetPortalTile(Route[Index]);
+		OutLegs.Add(FTileNavSearchLeg(GetSection(Route[Index]), FromTile, GetPortalTile(Route[Index])));
+	}
+	OutLegs.Add(FTileNavSearchLeg(EndSection, GetPortalTile(Route.Last()), EndTile));
+	return true;
+}
+
+bool FTileNavSnapshot::FindPortalPath(
+	const int32 StartSection,
+	const int32 StartTile,
+	const int32 EndSection,
+	const int32 EndTile,
+	const ETileNavSearchMode Mode,
+	bool& bFound,
+	TArray<FVector>& PathTiles,
+	TArray<int32>& PathSections,
+	FTileNavSearchStats& Stats,
+	const float ClearanceRadius) const {
+
+	TArray<FTileNavSearchLeg> Legs;
+	if (!FindPortalRoute(StartSection, StartTile, EndSection, EndTile, Legs, PathSections, Stats, ClearanceRadius)) {
+		return false;
+	}
+
+	// Refine each leg of the route within its section, stopping at the first leg that cannot be refined
+	bFound = true;
+	for (auto& Leg: Legs) {
+		const FTileNavGrid& Grid = *GetGrid(Leg.Section);
+		TArray<int32> LegTiles;
+		if (Leg.StartTile == Leg.EndTile) {
+			LegTiles.Add(Leg.EndTile);
+		} else if (!Grid.FindPath(Leg.StartTile, Leg.EndTile, Mode, LegTiles, Stats, Grid.GetClearanceLevel(ClearanceRadius))) {
+			bFound = false;
+			return true;
+		}
+		for (const int32 TileIndex: LegTiles) {
+			if (PathTiles.Num() == 0 || PathTiles.Last() != Grid.Locations[TileIndex]) {
+				PathTiles.Add(Grid.Locations[TileIndex]);
+			}
+		}
+	}
+	return true;
+}
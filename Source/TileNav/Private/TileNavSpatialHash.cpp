@@ -0,0 +1,115 @@
+#include "TileNavSpatialHash.h"
+#include "Algo/Unique.h"
+
+FTileNavPointHash::FTileNavPointHash(const float InCellSize): CellSize(FMath::Max(InCellSize, KINDA_SMALL_NUMBER)), NumPoints(0) {
+}
+
+FIntVector FTileNavPointHash::GetCell(const FVector& Location) const {
+	return FIntVector(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize),
+		FMath::FloorToInt(Location.Z / CellSize)
+	);
+}
+
+void FTileNavPointHash::Add(const FVector& Location) {
+	Cells.FindOrAdd(GetCell(Location)).Add(Location);
+	NumPoints++;
+}
+
+bool FTileNavPointHash::HasPointWithin(const FVector& Location, const float Radius) const {
+	checkSlow(Radius <= CellSize);
+
+	// Every point within one cell size lies in the 3x3x3 block of cells around the location
+	const FIntVector Center = GetCell(Location);
+	for (int32 Z = -1; Z <= 1; Z++) {
+		for (int32 Y = -1; Y <= 1; Y++) {
+			for (int32 X = -1; X <= 1; X++) {
+				const TArray<FVector>* Points = Cells.Find(Center + FIntVector(X, Y, Z));
+				if (!Points) {
+					continue;
+				}
+				for (auto& Point: *Points) {
+					if (FVector::Dist(Location, Point) <= Radius) {
+						return true;
+					}
+				}
+			}
+		}
+	}
+	return false;
+}
+
+FTileNavBoxHash::FTileNavBoxHash(const float InCellSize): CellSize(FMath::Max(InCellSize, KINDA_SMALL_NUMBER)) {
+}
+
+FIntVector FTileNavBoxHash::GetCell(const FVector& Location) const {
+	return FIntVector(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize),
+		FMath::FloorToInt(Location.Z / CellSize)
+	);
+}
+
+float FTileNavBoxHash::GetNumCells(const FBox& Box) const {
+
+	// Counted in floating point, since boxes such as an invalid query extent would overflow integer cell coordinates
+	const FVector Span = Box.GetSize() / CellSize + FVector(1.0f);
+	return Span.X * Span.Y * Span.Z;
+}
+
+void FTileNavBoxHash::Add(const FBox& Box, const int32 ID) {
+	if (!Box.IsValid) {
+		return;
+	}
+	const int32 BoxIndex = Boxes.Add(Box);
+	IDs.Add(ID);
+	if (GetNumCells(Box) > MaxCellsPerBox) {
+		OversizedBoxes.Add(BoxIndex);
+		return;
+	}
+	const FIntVector Min = GetCell(Box.Min);
+	const FIntVector Max = GetCell(Box.Max);
+	for (int32 Z = Min.Z; Z <= Max.Z; Z++) {
+		for (int32 Y = Min.Y; Y <= Max.Y; Y++) {
+			for (int32 X = Min.X; X <= Max.X; X++) {
+				Cells.FindOrAdd(FIntVector(X, Y, Z)).Add(BoxIndex);
+			}
+		}
+	}
+}
+
+void FTileNavBoxHash::Query(const FBox& Box, TArray<int32>& OutIDs) const {
+	OutIDs.Reset();
+	if (!Box.IsValid) {
+		return;
+	}
+	TArray<int32> Candidates = OversizedBoxes;
+	if (GetNumCells(Box) > Cells.Num()) {
+
+		// The query covers more cells than are occupied, so checking every box is cheaper
+		for (int32 BoxIndex = 0; BoxIndex < Boxes.Num(); BoxIndex++) {
+			Candidates.Add(BoxIndex);
+		}
+	} else {
+		const FIntVector Min = GetCell(Box.Min);
+		const FIntVector Max = GetCell(Box.Max);
+		for (int32 Z = Min.Z; Z <= Max.Z; Z++) {
+			for (int32 Y = Min.Y; Y <= Max.Y; Y++) {
+				for (int32 X = Min.X; X <= Max.X; X++) {
+					const TArray<int32>* CellBoxes = Cells.Find(FIntVector(X, Y, Z));
+					if (CellBoxes) {
+						Candidates.Append(*CellBoxes);
+					}
+				}
+			}
+		}
+	}
+	for (const int32 BoxIndex: Candidates) {
+		if (Boxes[BoxIndex].Intersect(Box)) {
+			OutIDs.Add(IDs[BoxIndex]);
+		}
+	}
+	OutIDs.Sort();
+	OutIDs.SetNum(Algo::Unique(OutIDs));
+}
@@ -1,11 +1,18 @@
 #include "TileNavigationData.h"
 #include "TileNavComponent.h"
+#include "TileNavCustomVersion.h"
+#include "TileNavSpatialHash.h"
 #include "DrawDebugHelpers.h"
 #include "Kismet/GameplayStatics.h"
+#include "Async/ParallelFor.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "Serialization/MemoryWriter.h"
 
 ATileNavigationData::ATileNavigationData(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer) {
     FindPathImplementation = FindPath;
+	PrimaryActorTick.bCanEverTick = true;
 }
 
 void ATileNavigationData::PostInitProperties() {
@@ -28,36 +35,529 @@ void ATileNavigationData::PostInitProperties() {
 
 }
 
+void ATileNavigationData::Serialize(FArchive& Ar) {
+	Super::Serialize(Ar);
+	Ar.UsingCustomVersion(FTileNavCustomVersion::GUID);
+	if (Ar.IsObjectReferenceCollector() || (Ar.IsLoading() && Ar.CustomVer(FTileNavCustomVersion::GUID) < FTileNavCustomVersion::BakedNavigationData)) {
+		return;
+	}
+
+	// Sections, components and the tile count are saved as properties, so only the checksum and grids are written here
+	const double StartTime = FPlatformTime::Seconds();
+	Ar << BuildChecksum;
+	if (Ar.IsLoading()) {
+		int32 NumGrids = 0;
+		Ar << NumGrids;
+		BakedGrids.Empty(NumGrids);
+		for (int32 Index = 0; Index < NumGrids && !Ar.IsError(); Index++) {
+			TSharedRef<FTileNavGrid, ESPMode::ThreadSafe> Grid = MakeShared<FTileNavGrid, ESPMode::ThreadSafe>();
+			Ar << *Grid;
+			BakedGrids.Add(Grid);
+		}
+		if (Ar.IsError()) {
+			BakedGrids.Empty();
+			BuildChecksum = 0;
+		}
+		BakedLoadMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	} else {
+
+		// Grids loaded with the level and not yet handed to their components are saved as they are
+		TArray<TSharedPtr<FTileNavGrid, ESPMode::ThreadSafe>> Grids = BakedGrids;
+		if (Grids.Num() == 0) {
+			for (auto& TileNav: TileNavComponents) {
+				Grids.Add(TileNav ? TileNav->Grid : MakeShared<FTileNavGrid, ESPMode::ThreadSafe>());
+			}
+		}
+		int32 NumGrids = Grids.Num();
+		Ar << NumGrids;
+		for (auto& Grid: Grids) {
+			Ar << *Grid;
+		}
+	}
+}
+
 void ATileNavigationData::BeginPlay() {
 	Super::BeginPlay();
 
-	// Rebuild the navigation on startup
-	RebuildAll();
+	// Load the baked navigation if it is still valid, otherwise rebuild on startup
+	const double StartTime = FPlatformTime::Seconds();
+	const bool bLoaded = bLoadBakedData && LoadBakedData();
+	if (!bLoaded) {
+		RebuildAll();
+	}
+	BakedGrids.Empty();
 	
 #if WITH_EDITOR
+	if (bLoaded) {
+		UE_LOG(LogNavigation, Warning, TEXT("TileNav startup: loaded baked navigation in %.2f ms (%.2f ms deserializing with the level)"),
+			(FPlatformTime::Seconds() - StartTime) * 1000.0, BakedLoadMilliseconds);
+	} else {
+		UE_LOG(LogNavigation, Warning, TEXT("TileNav startup: rebuilt navigation in %.2f ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	}
 	DebugDrawTileNav();
 #endif
 }
 
-void ATileNavigationData::RebuildAll() {
+void ATileNavigationData::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+	QueryService.Flush();
+	SliceScheduler.Empty();
+	PathCache.Empty();
+	Super::EndPlay(EndPlayReason);
+}
+
+void ATileNavigationData::TickActor(float DeltaTime, enum ELevelTick TickType, FActorTickFunction& ThisTickFunction) {
+	Super::TickActor(DeltaTime, TickType, ThisTickFunction);
+	bool bLogThroughput = false;
+#if WITH_EDITOR
+	bLogThroughput = bDisplayVerboseLogs;
+#endif
+	RefreshQuerySettings();
+	QueryService.Tick(AsyncQueryWorkers, bLogThroughput);
+	if (SliceScheduler.GetNumPending() > 0) {
+		TickSlicedQueries();
+	}
+	if (ClusterSize > 0) {
+		RefineActivePaths();
+	}
+	if (DirtyComponents.Num() > 0) {
+		RebuildDirtySections();
+	}
+}
+
+uint32 ATileNavigationData::RequestPathAsync(const FPathFindingQuery& Query, const FNavPathQueryDelegate& ResultDelegate) {
+	FPathFindingQuery AsyncQuery(Query);
+	if (!AsyncQuery.NavData.IsValid()) {
+		AsyncQuery.NavData = this;
+	}
+	return QueryService.Enqueue(AsyncQuery, ResultDelegate);
+}
+
+void ATileNavigationData::AbortPathAsync(const uint32 QueryID) {
+	QueryService.Abort(QueryID);
+}
+
+uint32 ATileNavigationData::RequestPathSliced(const FPathFindingQuery& Query, const FNavPathQueryDelegate& ResultDelegate, const int32 Priority, const FNavPathQueryDelegate& PartialDelegate) {
+	FTileNavSlicedRequest Request;
+	Request.Priority = Priority;
+	Request.Path = CreatePathInstance<FTileNavPath>(Query);
+	Request.Agent = Query.NavAgentProperties;
+	Request.ClearanceRadius = Query.NavAgentProperties.AgentRadius + Clearance;
+	Request.ResultDelegate = ResultDelegate;
+	Request.PartialDelegate = PartialDelegate;
+
+	// The route is planned now, and only the tile by tile refinement of its legs is sliced
+	const FTileNavSnapshotPtr CurrentSnapshot = GetSnapshot();
+	TArray<FTileNavSearchLeg> Legs;
+	TArray<int32> PathSections;
+	int32 StartSection, StartTile, EndSection, EndTile;
+	if (CurrentSnapshot.IsValid() && ProjectPathEnds(this, *CurrentSnapshot, Query, Request.ClearanceRadius, StartSection, StartTile, EndSection, EndTile) &&
+		CurrentSnapshot->IsReachable(StartSection, StartTile, EndSection, EndTile)) {
+		if (StartSection == EndSection) {
+			Legs.Add(FTileNavSearchLeg(StartSection, StartTile, EndTile));
+			PathSections.Add(StartSection);
+		} else {
+			FTileNavSearchStats RouteStats;
+			CurrentSnapshot->FindPortalRoute(StartSection, StartTile, EndSection, EndTile, Legs, PathSections, RouteStats, Request.ClearanceRadius);
+		}
+	}
+	Request.Query = MakeShared<FTileNavSlicedQuery, ESPMode::ThreadSafe>(CurrentSnapshot, Legs, PathSections, Request.ClearanceRadius);
+	return SliceScheduler.Enqueue(Request);
+}
+
+void ATileNavigationData::AbortPathSliced(const uint32 QueryID) {
+	SliceScheduler.Abort(QueryID);
+}
+
+void ATileNavigationData::TickSlicedQueries() {
+	TArray<FTileNavSlicedRequest> Finished;
+	TArray<FTileNavSlicedRequest> Advanced;
+	FTileNavSearchStats SliceStats;
+	SliceScheduler.Tick(SlicedQueryBudget / 1000.0, SlicedQueryMaxExpansions, Finished, Advanced, SliceStats);
 #if WITH_EDITOR
 	if (bDisplayVerboseLogs) {
-		UE_LOG(LogNavigation, Display, TEXT("Tile Navigation rebuild started."));
+		UE_LOG(LogNavigation, Display, TEXT("Sliced queries: %d tiles expanded in %.3f ms, %d finished, %d pending"),
+			SliceStats.Expansions, SliceStats.Milliseconds, Finished.Num(), SliceScheduler.GetNumPending());
 	}
 #endif
-    TileNavSections.Empty();
-	TileNavComponents.Empty();
 
-	if (!GetWorld()) {
+	// Delegates may queue or abort sliced queries, which only touches the scheduler's own list
+	for (auto& Request: Advanced) {
+		if (Request.PartialDelegate.IsBound()) {
+			const ENavigationQueryResult::Type Result = FillSlicedPath(Request);
+			Request.PartialDelegate.Execute(Request.QueryID, Result, Request.Path);
+		}
+	}
+	for (auto& Request: Finished) {
+		const ENavigationQueryResult::Type Result = FillSlicedPath(Request);
+		Request.ResultDelegate.ExecuteIfBound(Request.QueryID, Result, Request.Path);
+	}
+}
+
+ENavigationQueryResult::Type ATileNavigationData::FillSlicedPath(const FTileNavSlicedRequest& Request) const {
+	FNavigationPath* NavPath = Request.Path.Get();
+	if (!NavPath) {
+		return ENavigationQueryResult::Error;
+	}
+	const FTileNavSlicedQuery& Query = *Request.Query;
+	TArray<FVector> PathTiles;
+	const bool bFound = Query.GetPath(PathTiles);
+	if (Query.IsDone() && bPathPruning && PathTiles.Num() > 0) {
+		ApplyPathPruning(this, *Query.GetSnapshot(), PathTiles, Query.GetPathSections(), Request.Agent, Request.ClearanceRadius);
+	}
+	NavPath->ResetForRepath();
+	FTileNavPath* TileNavPath = NavPath->CastPath<FTileNavPath>();
+	if (TileNavPath) {
+		TileNavPath->PathSections = Query.GetPathSections();
+		TileNavPath->Agent = Request.Agent;
+		TileNavPath->ClearanceRadius = Request.ClearanceRadius;
+	}
+	if (PathTiles.Num() == 0) {
+		return ENavigationQueryResult::Fail;
+	}
+	for (auto& PathTile: PathTiles) {
+		NavPath->GetPathPoints().Add(FNavPathPoint(PathTile));
+	}
+	NavPath->SetIsPartial(!bFound);
+	NavPath->MarkReady();
+	return ENavigationQueryResult::Success;
+}
+
+void ATileNavigationData::UpdateSectionBounds() {
+	TArray<FBox> Bounds;
+	float CellSize = 0.0f;
+	int32 NumBounds = 0;
+	for (auto& TileNav: TileNavComponents) {
+		FBox SectionBox(ForceInit);
+		if (TileNav && TileNav->Grid->TileBounds.IsValid) {
+
+			// Pad by a tile so that locations between the outer tiles and the edge of the mesh still match
+			const FTileNavGrid& Grid = *TileNav->Grid;
+			SectionBox = Grid.TileBounds.ExpandBy(Grid.Interval * Grid.ComponentTransform.GetScale3D().GetAbsMax());
+			CellSize += SectionBox.GetSize().GetMax();
+			NumBounds++;
+		}
+		Bounds.Add(SectionBox);
+	}
+	TSharedRef<FTileNavBoxHash, ESPMode::ThreadSafe> BoundsHash = MakeShared<FTileNavBoxHash, ESPMode::ThreadSafe>(NumBounds > 0 ? CellSize / NumBounds : 1.0f);
+	for (int32 Index = 0; Index < Bounds.Num(); Index++) {
+		BoundsHash->Add(Bounds[Index], Index);
+	}
+	SectionBounds = BoundsHash;
+}
+
+void ATileNavigationData::UpdateSectionRoutes() {
+	TArray<TArray<FTileNavSectionLink>> Links;
+	Links.SetNum(TileNavSections.Num());
+	for (int32 Index = 0; Index < TileNavSections.Num(); Index++) {
+		if (!TileNavComponents[Index]) {
+			continue;
+		}
+
+		// Weigh each link by the walkable distance from the center of this section to its cheapest portal into the
+		// other section, across the gap, and on to the center of the other section
+		const FTileNavGrid& Grid = *TileNavComponents[Index]->Grid;
+		for (const int32 OtherIndex: TileNavSections[Index].Neighbors) {
+			int32 Portal, OtherPortal;
+			const float Cost = Grid.GetCenterCost(OtherIndex, Portal);
+			if (Portal == INDEX_NONE || !TileNavComponents[OtherIndex]) {
+				continue;
+			}
+			const FTileNavGrid& OtherGrid = *TileNavComponents[OtherIndex]->Grid;
+			const float OtherCost = OtherGrid.GetCenterCost(Index, OtherPortal);
+			const FVector PortalLocation = Grid.Locations[Grid.Portals[Portal].TileIndex];
+			Links[Index].Add(OtherPortal != INDEX_NONE
+				? FTileNavSectionLink(OtherIndex, Cost + FVector::Distance(PortalLocation, OtherGrid.Locations[OtherGrid.Portals[OtherPortal].TileIndex]) + OtherCost)
+				: FTileNavSectionLink(OtherIndex, Cost + FVector::Distance(PortalLocation, OtherGrid.GetCenterLocation())));
+		}
+	}
+
+	// Published snapshots may still be reading the current routes, so they are updated on a copy
+	const double StartTime = FPlatformTime::Seconds();
+	TSharedRef<FTileNavSectionRoutes, ESPMode::ThreadSafe> NewRoutes = SectionRoutes.IsValid()
+		? MakeShared<FTileNavSectionRoutes, ESPMode::ThreadSafe>(*SectionRoutes)
+		: MakeShared<FTileNavSectionRoutes, ESPMode::ThreadSafe>();
+	const int32 NumGoals = NewRoutes->Update(MoveTemp(Links), bParallelBuild);
+	SectionRoutes = NewRoutes;
 #if WITH_EDITOR
-		if (bDisplayVerboseLogs) {
-			UE_LOG(LogNavigation, Error, TEXT("World invalid. Cannot build Tile navigation."));
+	if (bDisplayVerboseLogs && NumGoals > 0) {
+		UE_LOG(LogNavigation, Display, TEXT("Section routes: %d of %d goals updated in %.2f ms, %.1f KB"),
+			NumGoals, NewRoutes->Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0, NewRoutes->GetAllocatedSize() / 1024.0f);
+	}
+#endif
+}
+
+void ATileNavigationData::PublishSnapshot() {
+	TSharedRef<FTileNavSnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FTileNavSnapshot, ESPMode::ThreadSafe>();
+	NewSnapshot->Sections = TileNavSections;
+	NewSnapshot->SectionBounds = SectionBounds;
+	NewSnapshot->SectionRoutes = SectionRoutes;
+	NewSnapshot->TileCount = TileCount;
+	NewSnapshot->PruningQueryParams.bTraceComplex = false;
+	NewSnapshot->PruningQueryParams.TraceTag = "TileNavPathPrune";
+	NewSnapshot->Settings = GetQuerySettings();
+	for (auto& TileNav: TileNavComponents) {
+
+		// Removed sections keep their slot, with no grid, so that section indices stay stable
+		if (!TileNav) {
+			NewSnapshot->Grids.Add(nullptr);
+			continue;
+		}
+		NewSnapshot->Grids.Add(TileNav->Grid);
+		NewSnapshot->PruningQueryParams.AddIgnoredComponent(TileNav);
+		NewSnapshot->PruningQueryParams.AddIgnoredComponents(TileNav->IgnoreComponents);
+	}
+
+	// A section's grid is replaced whenever it changes, so a new grid pointer moves its generation on. Generations are
+	// drawn from one counter so that a reused section index never repeats an old generation
+	const FTileNavSnapshotPtr PreviousSnapshot = GetSnapshot();
+	SectionGenerations.SetNumZeroed(NewSnapshot->Grids.Num());
+	for (int32 Index = 0; Index < NewSnapshot->Grids.Num(); Index++) {
+		if (!PreviousSnapshot.IsValid() || !PreviousSnapshot->Grids.IsValidIndex(Index) || PreviousSnapshot->Grids[Index] != NewSnapshot->Grids[Index]) {
+			SectionGenerations[Index] = ++LastSectionGeneration;
 		}
+	}
+	NewSnapshot->SectionGenerations = SectionGenerations;
+
+	// Regions are kept per grid as tiles change, so joining them across sections is only a pass over regions and portals
+	TSharedRef<FTileNavReachability, ESPMode::ThreadSafe> NewReachability = MakeShared<FTileNavReachability, ESPMode::ThreadSafe>();
+	NewReachability->Build(NewSnapshot->Grids);
+	NewSnapshot->Reachability = NewReachability;
+
+	FScopeLock Lock(&SnapshotLock);
+	Snapshot = NewSnapshot;
+}
+
+FTileNavQuerySettings ATileNavigationData::GetQuerySettings() const {
+	FTileNavQuerySettings Settings;
+	Settings.SearchMode = SearchMode;
+	Settings.PruningMode = PruningMode;
+	Settings.Clearance = Clearance;
+	Settings.PathCacheSize = PathCacheSize;
+	Settings.bPathPruning = bPathPruning;
+	Settings.bValidatePrunedPaths = bValidatePrunedPaths;
+	Settings.bPortalGraphSearch = bPortalGraphSearch;
+	Settings.bRepairActivePaths = bRepairActivePaths;
+#if WITH_EDITORONLY_DATA
+	Settings.bDisplayPaths = bDisplayPaths;
+	Settings.bDisplayVerboseLogs = bDisplayVerboseLogs;
 #endif
+	return Settings;
+}
+
+void ATileNavigationData::RefreshQuerySettings() {
+	const FTileNavSnapshotPtr CurrentSnapshot = GetSnapshot();
+	const FTileNavQuerySettings Settings = GetQuerySettings();
+	if (!CurrentSnapshot.IsValid() || CurrentSnapshot->Settings == Settings) {
 		return;
 	}
-	
-	// First, gather all TileNavComponents in the world
+
+	// Only the settings change, so the graph and its generations carry over as they are
+	TSharedRef<FTileNavSnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FTileNavSnapshot, ESPMode::ThreadSafe>(*CurrentSnapshot);
+	NewSnapshot->Settings = Settings;
+	FScopeLock Lock(&SnapshotLock);
+	Snapshot = NewSnapshot;
+}
+
+// Actor following a path, found through the controller or actor that queried it
+static const AActor* GetPathAgent(const FNavigationPath& Path) {
+	const UObject* Querier = Path.GetQuerier();
+	const AController* Controller = Cast<AController>(Querier);
+	return Controller ? Controller->GetPawn() : Cast<AActor>(Querier);
+}
+
+void ATileNavigationData::GetActivePaths(TArray<FNavPathSharedPtr>& OutPaths) {
+	FScopeLock Lock(&ActivePathsLock);
+	for (auto& ActivePath: ActivePaths) {
+		FNavPathSharedPtr Path = ActivePath.Pin();
+		if (Path.IsValid()) {
+			OutPaths.Add(Path);
+		}
+	}
+}
+
+void ATileNavigationData::RepairActivePaths(const int32 SectionIndex, const TArray<int32>& ChangedTiles) {
+	const FTileNavSnapshotPtr CurrentSnapshot = GetSnapshot();
+	const FTileNavGridConstPtr Grid = CurrentSnapshot.IsValid() && CurrentSnapshot->Grids.IsValidIndex(SectionIndex) ? CurrentSnapshot->Grids[SectionIndex] : nullptr;
+	if (!Grid.IsValid() || ChangedTiles.Num() == 0) {
+		return;
+	}
+	TArray<FNavPathSharedPtr> Paths;
+	GetActivePaths(Paths);
+	const double StartTime = FPlatformTime::Seconds();
+	FTileNavSearchStats SearchStats;
+	int32 NumRepaired = 0;
+	int32 NumInvalidated = 0;
+	for (auto& Path: Paths) {
+		FTileNavPath* TileNavPath = Path->CastPath<FTileNavPath>();
+		if (!TileNavPath || !TileNavPath->IsValid() || !TileNavPath->PathSections.Contains(SectionIndex)) {
+			continue;
+		}
+		const FTileNavIncrementalSearchPtr Repair = TileNavPath->Repair;
+		if (!Repair.IsValid() || Repair->GetSection() != SectionIndex) {
+			TileNavPath->Invalidate();
+			NumInvalidated++;
+			continue;
+		}
+
+		// Repair from wherever the agent has got to along the path, so that it is not sent back to where it started
+		int32 AgentTile = INDEX_NONE;
+		const AActor* Agent = GetPathAgent(*TileNavPath);
+		if (Agent) {
+			AgentTile = Grid->FindNearestWalkableTile(Agent->GetActorLocation(), Repair->GetMinClearance());
+		}
+		TArray<int32> PathIndices;
+		if (!Repair->Repair(Grid, ChangedTiles, AgentTile, SearchStats) || !Repair->GetPath(PathIndices)) {
+			TileNavPath->Repair.Reset();
+			TileNavPath->Invalidate();
+			NumInvalidated++;
+			continue;
+		}
+		TArray<FVector> PathTiles;
+		for (const int32 TileIndex: PathIndices) {
+			PathTiles.Add(Grid->Locations[TileIndex]);
+		}
+		if (bPathPruning) {
+			ApplyPathPruning(this, *CurrentSnapshot, PathTiles, TileNavPath->PathSections, TileNavPath->Agent, TileNavPath->ClearanceRadius);
+		}
+		TileNavPath->ResetForRepath();
+		for (auto& PathTile: PathTiles) {
+			TileNavPath->GetPathPoints().Add(FNavPathPoint(PathTile));
+		}
+		TileNavPath->SetIsPartial(false);
+		TileNavPath->MarkReady();
+		TileNavPath->DoneUpdating(ENavPathUpdateType::NavigationChanged);
+		NumRepaired++;
+	}
+#if WITH_EDITOR
+	if (bDisplayVerboseLogs && NumRepaired + NumInvalidated > 0) {
+		UE_LOG(LogNavigation, Display, TEXT("Active paths: %d repaired (%d tiles revisited), %d invalidated in %.2f ms"),
+			NumRepaired, SearchStats.Expansions, NumInvalidated, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	}
+#endif
+}
+
+void ATileNavigationData::RefineActivePaths() {
+	const FTileNavSnapshotPtr CurrentSnapshot = GetSnapshot();
+	if (!CurrentSnapshot.IsValid()) {
+		return;
+	}
+	TArray<FNavPathSharedPtr> Paths;
+	GetActivePaths(Paths);
+	const double StartTime = FPlatformTime::Seconds();
+	FTileNavSearchStats SearchStats;
+	int32 NumRefined = 0;
+	for (auto& Path: Paths) {
+		FTileNavPath* TileNavPath = Path->CastPath<FTileNavPath>();
+		if (!TileNavPath || !TileNavPath->IsValid() || !TileNavPath->ClusterRoute.IsValid() || TileNavPath->ClusterRoute->IsRefined()) {
+			continue;
+		}
+		const AActor* Agent = GetPathAgent(*TileNavPath);
+		if (!Agent) {
+			continue;
+		}
+		FTileNavClusterRoute& Route = *TileNavPath->ClusterRoute;
+		const int32 RefinedLegs = Route.GetNumRefinedLegs();
+		if (!Route.RefineAhead(Agent->GetActorLocation(), SearchStats)) {
+			TileNavPath->ClusterRoute.Reset();
+			TileNavPath->Invalidate();
+			continue;
+		}
+		if (Route.GetNumRefinedLegs() == RefinedLegs) {
+			continue;
+		}
+		TArray<FVector> PathTiles;
+		GetClusterPathTiles(this, *CurrentSnapshot, *TileNavPath, PathTiles);
+		TileNavPath->ResetForRepath();
+		for (auto& PathTile: PathTiles) {
+			TileNavPath->GetPathPoints().Add(FNavPathPoint(PathTile));
+		}
+		TileNavPath->SetIsPartial(false);
+		TileNavPath->MarkReady();
+		TileNavPath->DoneUpdating(ENavPathUpdateType::NavigationChanged);
+		NumRefined++;
+	}
+#if WITH_EDITOR
+	if (bDisplayVerboseLogs && NumRefined > 0) {
+		UE_LOG(LogNavigation, Display, TEXT("Cluster routes: %d refined ahead of their agents (%d tiles expanded) in %.2f ms"),
+			NumRefined, SearchStats.Expansions, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	}
+#endif
+}
+
+bool ATileNavigationData::IsReachable(const FVector Start, const FVector End) const {
+	const FTileNavSnapshotPtr CurrentSnapshot = GetSnapshot();
+	const float SearchRadius = FNavigationSystem::GetDefaultSupportedAgent().AgentHeight;
+	int32 StartSection, StartTile, EndSection, EndTile;
+	return CurrentSnapshot.IsValid() &&
+		CurrentSnapshot->FindNearestTile(Start, SearchRadius, StartSection, StartTile) &&
+		CurrentSnapshot->FindNearestTile(End, SearchRadius, EndSection, EndTile) &&
+		CurrentSnapshot->IsReachable(StartSection, StartTile, EndSection, EndTile);
+}
+
+FTileNavFlowFieldPtr ATileNavigationData::BuildFlowField(const FVector& Goal) const {
+	const FTileNavSnapshotPtr CurrentSnapshot = GetSnapshot();
+	int32 GoalSection, GoalTile;
+	if (!CurrentSnapshot.IsValid() || !CurrentSnapshot->FindNearestTile(Goal, FNavigationSystem::GetDefaultSupportedAgent().AgentHeight, GoalSection, GoalTile)) {
+		return nullptr;
+	}
+	FTileNavFlowFieldPtr FlowField = MakeShared<FTileNavFlowField, ESPMode::ThreadSafe>();
+	FlowField->Build(CurrentSnapshot, GoalSection, GoalTile, TileProximity);
+#if WITH_EDITOR
+	if (bDisplayVerboseLogs) {
+		UE_LOG(LogNavigation, Display, TEXT("Flow field built: %d tiles in %.2f ms, %.1f KB"),
+			FlowField->GetStats().Expansions, FlowField->GetStats().Milliseconds, FlowField->GetAllocatedSize() / 1024.0f);
+	}
+#endif
+	return FlowField;
+}
+
+bool ATileNavigationData::MoveFlowFieldGoal(FTileNavFlowField& FlowField, const FVector& Goal) const {
+	const FTileNavSnapshotPtr CurrentSnapshot = GetSnapshot();
+	int32 GoalSection, GoalTile;
+	if (!CurrentSnapshot.IsValid() || !CurrentSnapshot->FindNearestTile(Goal, FNavigationSystem::GetDefaultSupportedAgent().AgentHeight, GoalSection, GoalTile)) {
+		return false;
+	}
+	if (!FlowField.IsCurrent(*CurrentSnapshot)) {
+		FlowField.Build(CurrentSnapshot, GoalSection, GoalTile, TileProximity);
+	} else {
+		FlowField.SetSnapshot(CurrentSnapshot);
+		FlowField.MoveGoal(GoalSection, GoalTile);
+	}
+#if WITH_EDITOR
+	if (bDisplayVerboseLogs) {
+		UE_LOG(LogNavigation, Display, TEXT("Flow field goal moved: %d tiles revisited in %.2f ms"),
+			FlowField.GetStats().Expansions, FlowField.GetStats().Milliseconds);
+	}
+#endif
+	return true;
+}
+
+FTileNavPathCacheStats ATileNavigationData::GetPathCacheStats() const {
+	return PathCache.GetStats();
+}
+
+void ATileNavigationData::GetAgentClearances(float& OutWalkableClearance, float& OutMaxClearance) const {
+	OutWalkableClearance = FNavigationSystem::GetDefaultSupportedAgent().AgentRadius;
+	OutMaxClearance = OutWalkableClearance;
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (NavSys && NavSys->GetSupportedAgents().Num() > 0) {
+		OutWalkableClearance = MAX_FLT;
+		OutMaxClearance = 0.0f;
+		for (auto& Agent: NavSys->GetSupportedAgents()) {
+			OutWalkableClearance = FMath::Min(OutWalkableClearance, Agent.AgentRadius);
+			OutMaxClearance = FMath::Max(OutMaxClearance, Agent.AgentRadius);
+		}
+	}
+	OutWalkableClearance = FMath::Max(OutWalkableClearance, 0.0f) + Clearance;
+	OutMaxClearance = FMath::Max(OutMaxClearance + Clearance, OutWalkableClearance);
+}
+
+FTileNavSnapshotPtr ATileNavigationData::GetSnapshot() const {
+	FScopeLock Lock(&SnapshotLock);
+	return Snapshot;
+}
+
+void ATileNavigationData::GatherComponents(TArray<UTileNavComponent*>& OutComponents) const {
 	TArray<AActor*> Actors;
 	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AActor::StaticClass(), Actors);
 	for (auto& Actor: Actors) {
@@ -66,129 +566,531 @@ void ATileNavigationData::RebuildAll() {
 		for (auto& TileNavActorComponent: TileNavActorComponents) {
 			UTileNavComponent* TileNav = Cast<UTileNavComponent>(TileNavActorComponent);
 			if (TileNav) {
-				TileNav->SectionIndex = TileNavComponents.Num();
-				TileNav->BuildNavigationTiles(GridScale, Clearance);
-				TileNavComponents.Add(TileNav);
+				OutComponents.Add(TileNav);
 			}
 		}
 	}
+}
+
+uint32 ATileNavigationData::CalculateBuildChecksum(const TArray<UTileNavComponent*>& Components) const {
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	int32 Version = FTileNavCustomVersion::LatestVersion;
+	float WalkableClearance, MaxClearance;
+	GetAgentClearances(WalkableClearance, MaxClearance);
+	float BuildSettings[9] = {
+		GridScale,
+		Clearance,
+		ComponentProximity,
+		TileProximity,
+		WalkableClearance,
+		MaxClearance,
+		static_cast<float>(NumLandmarks),
+		static_cast<float>(ClusterSize),
+		static_cast<float>(MinClusteredTiles)
+	};
+	Writer << Version;
+	Writer.Serialize(BuildSettings, sizeof(BuildSettings));
+
+	// Names rather than paths are used for ignored components, since paths differ between the editor and PIE worlds
+	for (auto& TileNav: Components) {
+		FTransform Transform = TileNav->GetComponentTransform();
+		float TileGridSize = TileNav->GridSize;
+		FRotator TraceNormal = TileNav->CollisionTraceNormal;
+		FString MeshPath = GetPathNameSafe(TileNav->GetStaticMesh());
+		Writer << Transform << TileGridSize << TraceNormal << MeshPath;
+		for (auto& IgnoreComponent: TileNav->IgnoreComponents) {
+			FString IgnoreName = IgnoreComponent ? GetNameSafe(IgnoreComponent->GetOwner()) + "." + IgnoreComponent->GetName() : FString();
+			Writer << IgnoreName;
+		}
+	}
+
+	// Zero is reserved for navigation that has never been built
+	const uint32 Checksum = FCrc::MemCrc32(Bytes.GetData(), Bytes.Num());
+	return Checksum != 0 ? Checksum : 1;
+}
+
+bool ATileNavigationData::LoadBakedData() {
+	if (BuildChecksum == 0 || BakedGrids.Num() != TileNavComponents.Num() || TileNavSections.Num() != TileNavComponents.Num()) {
+		return false;
+	}
+	TArray<UTileNavComponent*> Components;
+	GatherComponents(Components);
+	if (Components != TileNavComponents || CalculateBuildChecksum(Components) != BuildChecksum) {
+#if WITH_EDITOR
+		if (bDisplayVerboseLogs) {
+			UE_LOG(LogNavigation, Display, TEXT("Baked navigation is out of date and will be rebuilt"));
+		}
+#endif
+		return false;
+	}
+	int32 BakedTileCount = 0;
+	for (auto& Grid: BakedGrids) {
+		BakedTileCount += Grid->NumTiles;
+	}
+	if (BakedTileCount != TileCount) {
+		return false;
+	}
+
+	// Hand the grids over to their components as they are, without copying the tile arrays
+	for (int32 Index = 0; Index < TileNavComponents.Num(); Index++) {
+		TileNavComponents[Index]->SectionIndex = Index;
+		TileNavComponents[Index]->NavigationData = this;
+		TileNavComponents[Index]->Grid = BakedGrids[Index];
+		TileNavComponents[Index]->Grid->BidirectionalDistance = GetBidirectionalDistance();
+	}
+	BakedGrids.Empty();
+	DirtyComponents.Empty();
+	SectionRoutes.Reset();
+	UpdateSectionBounds();
+	UpdateSectionRoutes();
+	PublishSnapshot();
+	return true;
+}
+
+void ATileNavigationData::MarkComponentDirty(UTileNavComponent* TileNav) {
+
+	// Components registered before begin play are gathered by the full rebuild
+	if (TileNav && HasActorBegunPlay() && !IsActorBeingDestroyed()) {
+		DirtyComponents.Add(TileNav);
+	}
+}
+
+void ATileNavigationData::RebuildAll() {
+#if WITH_EDITOR
+	if (bDisplayVerboseLogs) {
+		UE_LOG(LogNavigation, Display, TEXT("Tile Navigation rebuild started."));
+	}
+#endif
+    TileNavSections.Empty();
+	TileNavComponents.Empty();
+	DirtyComponents.Empty();
+	BakedGrids.Empty();
+	SectionRoutes.Reset();
+	PathCache.Empty();
+	BuildChecksum = 0;
+
+	if (!GetWorld()) {
+#if WITH_EDITOR
+		if (bDisplayVerboseLogs) {
+			UE_LOG(LogNavigation, Error, TEXT("World invalid. Cannot build Tile navigation."));
+		}
+#endif
+		return;
+	}
+	
+	// First, gather all TileNavComponents in the world
+	double PhaseStartTime = FPlatformTime::Seconds();
+	GatherComponents(TileNavComponents);
+	for (int32 Index = 0; Index < TileNavComponents.Num(); Index++) {
+		TileNavComponents[Index]->SectionIndex = Index;
+		TileNavComponents[Index]->NavigationData = this;
+	}
+	const double GatherMilliseconds = (FPlatformTime::Seconds() - PhaseStartTime) * 1000.0;
+
+	// Build each section's tiles. Components are independent so they are built in parallel, and each build
+	// distributes its own scene queries across workers by row
+	PhaseStartTime = FPlatformTime::Seconds();
+	TArray<FTileNavBuildStats> ComponentBuildStats;
+	ComponentBuildStats.SetNum(TileNavComponents.Num());
+	float WalkableClearance, MaxClearance;
+	GetAgentClearances(WalkableClearance, MaxClearance);
+	ParallelFor(TileNavComponents.Num(), [this, &ComponentBuildStats, WalkableClearance, MaxClearance](const int32 Index) {
+		TileNavComponents[Index]->BuildNavigationTiles(GridScale, WalkableClearance, MaxClearance, bParallelBuild, ComponentBuildStats[Index]);
+		TileNavComponents[Index]->Grid->BuildLandmarks(NumLandmarks);
+		TileNavComponents[Index]->Grid->BuildClusters(ClusterSize, MinClusteredTiles);
+		TileNavComponents[Index]->Grid->BidirectionalDistance = GetBidirectionalDistance();
+	}, !bParallelBuild);
+	const double BuildMilliseconds = (FPlatformTime::Seconds() - PhaseStartTime) * 1000.0;
+	FTileNavBuildStats BuildStats;
+	for (auto& ComponentStats: ComponentBuildStats) {
+		BuildStats += ComponentStats;
+	}
+
+	// Link sections serially, in component order, so that linkage is deterministic. Proximal pairs and nearby edge tiles
+	// are found through spatial hashes, which gives the same links as testing every pair
+	PhaseStartTime = FPlatformTime::Seconds();
+	TArray<TArray<int32>> ProximalSections;
+	FindProximalSections(nullptr, ProximalSections);
+	TArray<FTileNavPointHash> EdgeTileHashes;
+	for (auto& TileNav: TileNavComponents) {
+		EdgeTileHashes.Add(MakeEdgeTileHash(*TileNav->Grid, TileProximity));
+	}
 
 	TileCount = 0;
 	int32 LinkedEdgeTileCount = 0;
+	SIZE_T TileMemory = 0;
+	SIZE_T ClearanceMemory = 0;
+	SIZE_T LandmarkMemory = 0;
+	SIZE_T ClusterMemory = 0;
+	int32 ClusteredSections = 0;
 	for (auto& TileNav: TileNavComponents) {
-		TileCount += TileNav->Tiles.Num();
-		LinkedEdgeTileCount += TileNav->EdgeTiles.Num();
+		TileCount += TileNav->Grid->NumTiles;
+		LinkedEdgeTileCount += TileNav->Grid->EdgeTiles->Num();
+		TileMemory += TileNav->Grid->GetAllocatedSize();
+		ClearanceMemory += TileNav->Grid->Clearances->GetAllocatedSize();
+		LandmarkMemory += TileNav->Grid->LandmarkDistances->GetAllocatedSize();
+		ClusterMemory += TileNav->Grid->Clusters.GetAllocatedSize();
+		ClusteredSections += TileNav->Grid->Clusters.IsEnabled() ? 1 : 0;
 		FTileNavSection NavSection(TileNav->SectionIndex);
 
-		// Perform a proximity check between each TileNav component and all others 
-		for (auto& OtherNav: TileNavComponents) {
-			if (OtherNav == TileNav) {
-				continue;
-			}
-			TArray<UPrimitiveComponent*> OutComponents;				
-			UKismetSystemLibrary::SphereOverlapComponents(
-				GetWorld(),
-				(TileNav->GetComponentLocation() + OtherNav->GetComponentLocation()) * 0.5f,
-				ComponentProximity,
-				{ObjectTypeQuery1, ObjectTypeQuery2},
-				UTileNavComponent::StaticClass(),
-				{},
-				OutComponents
-			);
-
-			if (OutComponents.ContainsByPredicate([TileNav] (UPrimitiveComponent*& Component) {
-				return Component == TileNav;
-			}) && OutComponents.ContainsByPredicate([OtherNav] (UPrimitiveComponent*& Component) {
-                return Component == OtherNav;
-            })) {
-				// Find and link tiles
-				TArray<FVector> TileEdgeKeys;
-				TileNav->EdgeTiles.GetKeys(TileEdgeKeys);
-				for (auto& Tile: TileEdgeKeys) {
-					for (auto& Other: OtherNav->EdgeTiles) {
-						if (FVector::Dist(Tile, Other.Key) <= TileProximity) {
-							TArray<int32> NeighborSections;
-							if (TileNav->EdgeTiles.Contains(Tile)) {
-								NeighborSections = TileNav->EdgeTiles[Tile].NavSections;
-							}
-							NeighborSections.AddUnique(OtherNav->SectionIndex);
-							TileNav->EdgeTiles.Add(Tile, FEdgeNeighbors(NeighborSections));
-
-							// Nav sections are proximal so add the other TileNav component as a neighbor
-							NavSection.Neighbors.AddUnique(OtherNav->SectionIndex);
-						}
-					}
-				}
+		// Nav sections are proximal so add the other TileNav component as a neighbor if any of their edge tiles link
+		for (const int32 OtherIndex: ProximalSections[TileNav->SectionIndex]) {
+			if (LinkEdgeTiles(*TileNav->Grid, EdgeTileHashes[OtherIndex], OtherIndex, TileProximity)) {
+				NavSection.Neighbors.AddUnique(OtherIndex);
 			}
 		}
 		TileNavSections.Add(NavSection);
     }
+
+	// Portals depend only on each section's own links, so their walkable distances are found in parallel
+	ParallelFor(TileNavComponents.Num(), [this](const int32 Index) {
+		TileNavComponents[Index]->Grid->BuildPortals();
+	}, !bParallelBuild);
+	UpdateSectionRoutes();
+	const double LinkMilliseconds = (FPlatformTime::Seconds() - PhaseStartTime) * 1000.0;
+	BuildChecksum = CalculateBuildChecksum(TileNavComponents);
+	UpdateSectionBounds();
+	PublishSnapshot();
 #if WITH_EDITOR
+	UE_LOG(LogNavigation, Warning, TEXT("Build phases: gather %.2f ms, build %.2f ms (trace %.2f ms, clearance %.2f ms, merge %.2f ms summed over sections), link %.2f ms"),
+		GatherMilliseconds, BuildMilliseconds, BuildStats.TraceMilliseconds, BuildStats.ClearanceMilliseconds, BuildStats.MergeMilliseconds, LinkMilliseconds);
 	UE_LOG(LogNavigation, Warning, TEXT("Nav sections: %d"), TileNavSections.Num());
 	UE_LOG(LogNavigation, Warning, TEXT("Walkable tiles: %d"), TileCount);
 	UE_LOG(LogNavigation, Warning, TEXT("Linked edge tiles: %d"), LinkedEdgeTileCount);
+	UE_LOG(LogNavigation, Warning, TEXT("Tile memory: %.1f KB (%.1f bytes per tile)"),
+		TileMemory / 1024.0f, TileCount > 0 ? static_cast<float>(TileMemory) / TileCount : 0.0f);
+	UE_LOG(LogNavigation, Warning, TEXT("Tile clearance memory: %.1f KB, serving agent clearances from %.0f to %.0f"),
+		ClearanceMemory / 1024.0f, WalkableClearance, MaxClearance);
+	if (NumLandmarks > 0) {
+		UE_LOG(LogNavigation, Warning, TEXT("Landmark memory: %.1f KB"), LandmarkMemory / 1024.0f);
+		if (bDisplayVerboseLogs) {
+			LogLandmarks();
+		}
+	}
+	if (ClusterSize > 0) {
+		UE_LOG(LogNavigation, Warning, TEXT("Cluster memory: %.1f KB over %d clustered sections"), ClusterMemory / 1024.0f, ClusteredSections);
+	}
 	DebugDrawTileNav();
 #endif
 }
 
-int32 ATileNavigationData::GetNearestSection(const ATileNavigationData* NavGraph, const FVector Location, const float Radius) {
-	TArray<UPrimitiveComponent*> OutComponents;				
-	UKismetSystemLibrary::SphereOverlapComponents(
-        NavGraph->GetWorld(),
-        Location,
-        Radius,
-        {ObjectTypeQuery1, ObjectTypeQuery2},
-        UTileNavComponent::StaticClass(),
-        {},
-        OutComponents
-    );
+#if WITH_EDITOR
+void ATileNavigationData::LogLandmarks() const {
+
+	// Sample searches with and without landmarks show what the extra memory buys in each section
+	for (auto& TileNav: TileNavComponents) {
+		const FTileNavGrid* Grid = TileNav ? TileNav->Grid.Get() : nullptr;
+		if (!Grid || Grid->Landmarks.Num() == 0) {
+			continue;
+		}
+		FTileNavSearchStats PlainStats, LandmarkStats;
+		Grid->MeasureLandmarks(16, PlainStats, LandmarkStats);
+		UE_LOG(LogNavigation, Display, TEXT("Section %d: %d landmarks, %.1f KB. Sample searches expanded %d tiles in %.2f ms with landmarks, %d tiles in %.2f ms without (%.0f%% fewer)"),
+			TileNav->SectionIndex, Grid->Landmarks.Num(), Grid->LandmarkDistances->GetAllocatedSize() / 1024.0f,
+			LandmarkStats.Expansions, LandmarkStats.Milliseconds, PlainStats.Expansions, PlainStats.Milliseconds,
+			PlainStats.Expansions > 0 ? 100.0f * (PlainStats.Expansions - LandmarkStats.Expansions) / PlainStats.Expansions : 0.0f);
+	}
+}
+#endif
+
+void ATileNavigationData::RebuildDirtySections() {
+	double PhaseStartTime = FPlatformTime::Seconds();
+	TSet<int32> ChangedSections;
+
+	// Sections whose components were unregistered or destroyed keep an empty slot. A destroyed component may already
+	// have been collected, in which case its slot is null but the published snapshot still has its grid
+	const FTileNavSnapshotPtr CurrentSnapshot = GetSnapshot();
+	for (int32 Index = 0; Index < TileNavComponents.Num(); Index++) {
+		UTileNavComponent* TileNav = TileNavComponents[Index];
+		const bool bRemoved = TileNav
+			? TileNav->IsPendingKill() || !TileNav->IsRegistered()
+			: CurrentSnapshot.IsValid() && CurrentSnapshot->GetGrid(Index) != nullptr;
+		if (bRemoved) {
+			TileNavComponents[Index] = nullptr;
+			ChangedSections.Add(Index);
+		}
+	}
+
+	// Rebuild dirty components that are still registered, appending new ones as new sections
+	TArray<UTileNavComponent*> DirtySections;
+	for (auto& DirtyComponent: DirtyComponents) {
+		UTileNavComponent* TileNav = DirtyComponent.Get();
+		if (!TileNav || !TileNav->IsRegistered()) {
+			continue;
+		}
+		if (!TileNavComponents.IsValidIndex(TileNav->SectionIndex) || TileNavComponents[TileNav->SectionIndex] != TileNav) {
+			TileNav->SectionIndex = TileNavComponents.Num();
+			TileNav->NavigationData = this;
+			TileNavComponents.Add(TileNav);
+			TileNavSections.Add(FTileNavSection(TileNav->SectionIndex));
+		}
+		DirtySections.Add(TileNav);
+		ChangedSections.Add(TileNav->SectionIndex);
+	}
+	DirtyComponents.Empty();
+	if (ChangedSections.Num() == 0) {
+		return;
+	}
+	
+	TArray<FTileNavBuildStats> ComponentBuildStats;
+	ComponentBuildStats.SetNum(DirtySections.Num());
+	float WalkableClearance, MaxClearance;
+	GetAgentClearances(WalkableClearance, MaxClearance);
+	ParallelFor(DirtySections.Num(), [this, &DirtySections, &ComponentBuildStats, WalkableClearance, MaxClearance](const int32 Index) {
+		DirtySections[Index]->BuildNavigationTiles(GridScale, WalkableClearance, MaxClearance, bParallelBuild, ComponentBuildStats[Index]);
+		DirtySections[Index]->Grid->BuildLandmarks(NumLandmarks);
+		DirtySections[Index]->Grid->BuildClusters(ClusterSize, MinClusteredTiles);
+		DirtySections[Index]->Grid->BidirectionalDistance = GetBidirectionalDistance();
+	}, !bParallelBuild);
+	const double BuildMilliseconds = (FPlatformTime::Seconds() - PhaseStartTime) * 1000.0;
 
-	if (OutComponents.Num() > 0) {
-		UTileNavComponent* TileNav = Cast<UTileNavComponent>(OutComponents[0]);
+	PhaseStartTime = FPlatformTime::Seconds();
+	RelinkSections(ChangedSections);
+	UpdateSectionRoutes();
+	TileCount = 0;
+	for (auto& TileNav: TileNavComponents) {
 		if (TileNav) {
-			return TileNav->SectionIndex;
+			TileCount += TileNav->Grid->NumTiles;
 		}
 	}
-	return -1;
+	const double LinkMilliseconds = (FPlatformTime::Seconds() - PhaseStartTime) * 1000.0;
+
+	// Queries already running keep the previous snapshot, so nothing waits on the rebuild
+	UpdateSectionBounds();
+	PublishSnapshot();
+#if WITH_EDITOR
+	if (bDisplayVerboseLogs) {
+		UE_LOG(LogNavigation, Display, TEXT("Incremental rebuild: %d sections rebuilt, %d removed, build %.2f ms, link %.2f ms"),
+			DirtySections.Num(), ChangedSections.Num() - DirtySections.Num(), BuildMilliseconds, LinkMilliseconds);
+	}
+	DebugDrawTileNav();
+#endif
 }
 
-FVector ATileNavigationData::GetNearestNavTile(UTileNavComponent* TileNavComponent, const FVector Location) const {
-	if (TileNavComponent->Tiles.Num() == 0) {
-		return FVector::ZeroVector;
+void ATileNavigationData::RelinkSections(const TSet<int32>& ChangedSections) {
+	const auto IsChanged = [&ChangedSections](const int32 SectionIndex) {
+		return ChangedSections.Contains(SectionIndex);
+	};
+
+	// Unlink every unchanged section from the changed ones. Their grids may be shared with a published snapshot,
+	// so links are removed from a copy. Changed sections have freshly built grids, or none if they were removed
+	TSet<int32> CopiedSections;
+	for (auto& NavSection: TileNavSections) {
+		if (IsChanged(NavSection.SectionIndex)) {
+			NavSection.Neighbors.Empty();
+			continue;
+		}
+		UTileNavComponent* TileNav = TileNavComponents[NavSection.SectionIndex];
+		if (!TileNav || !NavSection.Neighbors.ContainsByPredicate(IsChanged)) {
+			continue;
+		}
+		NavSection.Neighbors.RemoveAll(IsChanged);
+		TileNav->Grid = MakeShared<FTileNavGrid, ESPMode::ThreadSafe>(*TileNav->Grid);
+		CopiedSections.Add(NavSection.SectionIndex);
+		for (auto& Tile: TileNav->Grid->EdgeTiles.Edit()) {
+			Tile.Value.NavSections.RemoveAll(IsChanged);
+		}
+	}
+
+	// Link the changed sections in both directions. Changed pairs are linked once from each side
+	TArray<TArray<int32>> ProximalSections;
+	FindProximalSections(&ChangedSections, ProximalSections);
+	TMap<int32, FTileNavPointHash> EdgeTileHashes;
+	const auto GetEdgeTileHash = [this, &EdgeTileHashes](const int32 SectionIndex) -> const FTileNavPointHash& {
+		const FTileNavPointHash* EdgeTileHash = EdgeTileHashes.Find(SectionIndex);
+		return EdgeTileHash ? *EdgeTileHash : EdgeTileHashes.Add(SectionIndex, MakeEdgeTileHash(*TileNavComponents[SectionIndex]->Grid, TileProximity));
+	};
+	for (const int32 SectionIndex: ChangedSections) {
+		UTileNavComponent* TileNav = TileNavComponents[SectionIndex];
+		if (!TileNav) {
+			continue;
+		}
+		for (const int32 OtherIndex: ProximalSections[SectionIndex]) {
+			UTileNavComponent* OtherNav = TileNavComponents[OtherIndex];
+			if (LinkEdgeTiles(*TileNav->Grid, GetEdgeTileHash(OtherIndex), OtherIndex, TileProximity)) {
+				TileNavSections[SectionIndex].Neighbors.AddUnique(OtherIndex);
+			}
+			if (IsChanged(OtherIndex)) {
+				continue;
+			}
+			if (!CopiedSections.Contains(OtherIndex)) {
+				OtherNav->Grid = MakeShared<FTileNavGrid, ESPMode::ThreadSafe>(*OtherNav->Grid);
+				CopiedSections.Add(OtherIndex);
+			}
+			if (LinkEdgeTiles(*OtherNav->Grid, GetEdgeTileHash(SectionIndex), SectionIndex, TileProximity)) {
+				TileNavSections[OtherIndex].Neighbors.AddUnique(SectionIndex);
+			}
+		}
 	}
-	TArray<float> Distances;			
-	for (auto& Tile: TileNavComponent->Tiles) {
-		if (Tile.Value.bWalkable) {
-			Distances.Add(FVector::DistSquared(Location, Tile.Key));	
+
+	// A full rebuild links sections in ascending order, so sort the touched links to match it
+	CopiedSections.Append(ChangedSections);
+	TArray<int32> TouchedSections;
+	for (const int32 SectionIndex: CopiedSections) {
+		TileNavSections[SectionIndex].Neighbors.Sort();
+		if (TileNavComponents[SectionIndex]) {
+			for (auto& Tile: TileNavComponents[SectionIndex]->Grid->EdgeTiles.Edit()) {
+				Tile.Value.NavSections.Sort();
+			}
+			TouchedSections.Add(SectionIndex);
 		}
 	}
-	int32 MinIndex;
-	FMath::Min(Distances, &MinIndex);
-	TArray<FVector> TileKeys;
-	TileNavComponent->Tiles.GetKeys(TileKeys);
-	return TileKeys[MinIndex];
+
+	// Only sections whose links changed need their portals rebuilt
+	ParallelFor(TouchedSections.Num(), [this, &TouchedSections](const int32 Index) {
+		TileNavComponents[TouchedSections[Index]]->Grid->BuildPortals();
+	}, !bParallelBuild);
+}
+
+FBox ATileNavigationData::GetProximityBounds(const UTileNavComponent* TileNav) const {
+	FBox ProximityBounds = TileNav->Bounds.GetBox();
+	ProximityBounds += TileNav->BodyInstance.GetBodyBounds();
+	return ProximityBounds.ExpandBy(ComponentProximity);
+}
+
+void ATileNavigationData::FindProximalSections(const TSet<int32>* ChangedSections, TArray<TArray<int32>>& OutProximalSections) const {
+	OutProximalSections.Reset();
+	OutProximalSections.SetNum(TileNavComponents.Num());
+
+	// The proximity sphere sits midway between the two components, so it can only touch both when the midpoint is
+	// inside both of their bounds expanded by the proximity distance. Cells are sized to the average expanded bounds
+	TArray<FBox> ProximityBounds;
+	ProximityBounds.SetNum(TileNavComponents.Num());
+	float CellSize = 0.0f;
+	int32 NumBounds = 0;
+	for (int32 Index = 0; Index < TileNavComponents.Num(); Index++) {
+		if (TileNavComponents[Index]) {
+			ProximityBounds[Index] = GetProximityBounds(TileNavComponents[Index]);
+			CellSize += ProximityBounds[Index].GetSize().GetMax();
+			NumBounds++;
+		}
+	}
+	FTileNavBoxHash BoundsHash(NumBounds > 0 ? CellSize / NumBounds : 1.0f);
+	for (int32 Index = 0; Index < TileNavComponents.Num(); Index++) {
+		if (TileNavComponents[Index]) {
+			BoundsHash.Add(ProximityBounds[Index], Index);
+		}
+	}
+
+	// The proximity test is symmetric, so each pair is only tested once
+	TArray<int32> Sections;
+	if (ChangedSections) {
+		Sections = ChangedSections->Array();
+	} else {
+		for (int32 Index = 0; Index < TileNavComponents.Num(); Index++) {
+			Sections.Add(Index);
+		}
+	}
+	TArray<int32> Candidates;
+	for (const int32 SectionIndex: Sections) {
+		UTileNavComponent* TileNav = TileNavComponents[SectionIndex];
+		if (!TileNav) {
+			continue;
+		}
+		BoundsHash.Query(ProximityBounds[SectionIndex], Candidates);
+		for (const int32 OtherIndex: Candidates) {
+			if (OtherIndex == SectionIndex || (OtherIndex < SectionIndex && (!ChangedSections || ChangedSections->Contains(OtherIndex)))) {
+				continue;
+			}
+			UTileNavComponent* OtherNav = TileNavComponents[OtherIndex];
+			const FVector Midpoint = (TileNav->GetComponentLocation() + OtherNav->GetComponentLocation()) * 0.5f;
+			if (ProximityBounds[SectionIndex].IsInsideOrOn(Midpoint) &&
+				ProximityBounds[OtherIndex].IsInsideOrOn(Midpoint) &&
+				AreSectionsProximal(TileNav, OtherNav)) {
+				OutProximalSections[SectionIndex].Add(OtherIndex);
+				OutProximalSections[OtherIndex].Add(SectionIndex);
+			}
+		}
+	}
+	for (auto& ProximalSections: OutProximalSections) {
+		ProximalSections.Sort();
+	}
+}
+
+bool ATileNavigationData::AreSectionsProximal(UTileNavComponent* TileNav, UTileNavComponent* OtherNav) const {
+
+	// Equivalent to a world static and dynamic sphere overlap query at the midpoint, run against the two bodies only
+	const auto IsQueryable = [](const UTileNavComponent* Component) {
+		const ECollisionChannel ObjectType = Component->GetCollisionObjectType();
+		return Component->IsQueryCollisionEnabled() && (ObjectType == ECC_WorldStatic || ObjectType == ECC_WorldDynamic);
+	};
+	if (!IsQueryable(TileNav) || !IsQueryable(OtherNav)) {
+		return false;
+	}
+	const FVector Midpoint = (TileNav->GetComponentLocation() + OtherNav->GetComponentLocation()) * 0.5f;
+	const FCollisionShape Sphere = FCollisionShape::MakeSphere(ComponentProximity);
+	return TileNav->OverlapComponent(Midpoint, FQuat::Identity, Sphere) && OtherNav->OverlapComponent(Midpoint, FQuat::Identity, Sphere);
+}
+
+FTileNavPointHash ATileNavigationData::MakeEdgeTileHash(const FTileNavGrid& Grid, const float TileProximity) {
+	FTileNavPointHash EdgeTileHash(TileProximity);
+	for (auto& Tile: Grid.EdgeTiles) {
+		EdgeTileHash.Add(Grid.Locations[Tile.Key]);
+	}
+	return EdgeTileHash;
+}
+
+bool ATileNavigationData::LinkEdgeTiles(
+	FTileNavGrid& Grid,
+	const FTileNavPointHash& OtherEdgeTiles,
+	const int32 OtherSectionIndex,
+	const float TileProximity) {
+
+	bool bLinked = false;
+	for (auto& Tile: Grid.EdgeTiles.Edit()) {
+		if (OtherEdgeTiles.HasPointWithin(Grid.Locations[Tile.Key], TileProximity)) {
+			Tile.Value.NavSections.AddUnique(OtherSectionIndex);
+			bLinked = true;
+		}
+	}
+	return bLinked;
+}
+
+bool ATileNavigationData::ProjectPoint(
+	const FVector& Point,
+	FNavLocation& OutLocation,
+	const FVector& Extent,
+	FSharedConstNavQueryFilter Filter,
+	const UObject* Querier) const {
+
+	const FTileNavSnapshotPtr NavSnapshot = GetSnapshot();
+	if (!NavSnapshot.IsValid()) {
+		return false;
+	}
+	int32 SectionIndex, TileIndex;
+	if (!NavSnapshot->FindNearestTile(Point, Extent.GetMax(), SectionIndex, TileIndex)) {
+		return false;
+	}
+	const FTileNavGrid* Grid = NavSnapshot->GetGrid(SectionIndex);
+	if (!FBox(Point - Extent, Point + Extent).IsInsideOrOn(Grid->Locations[TileIndex])) {
+		return false;
+	}
+
+	// Node refs hold the section index in the upper half and the tile index in the lower half
+	OutLocation = FNavLocation(Grid->Locations[TileIndex], (static_cast<NavNodeRef>(SectionIndex) << 32) | static_cast<uint32>(TileIndex));
+	return true;
 }
 
 bool ATileNavigationData::GetNearestEdgeTile(
 	const FVector Location,
-	UTileNavComponent* TileNav,
-	UTileNavComponent* OtherTileNav,
+	const FTileNavGrid& Grid,
+	const int32 OtherSectionIndex,
 	FVector &OutLocation) {
 
-	TArray<FVector> CandidateKeys;
-	for (auto& Tile: TileNav->EdgeTiles) {
-		if (Tile.Value.NavSections.Contains(OtherTileNav->SectionIndex)) {
-			CandidateKeys.Add(Tile.Key);
+	int32 MinIndex = INDEX_NONE;
+	float MinDistance = MAX_FLT;
+	for (auto& Tile: Grid.EdgeTiles) {
+		if (Tile.Value.NavSections.Contains(OtherSectionIndex)) {
+			const float Distance = FVector::DistSquared(Location, Grid.Locations[Tile.Key]);
+			if (Distance < MinDistance) {
+				MinDistance = Distance;
+				MinIndex = Tile.Key;
+			}
 		}
 	}
-	if (CandidateKeys.Num() > 0) {
-		TArray<float> Distances;			
-		for (auto& Candidate: CandidateKeys) {
-			Distances.Add(FVector::DistSquared(Location, Candidate));
-		}
-		int32 MinIndex;
-		FMath::Min(Distances, &MinIndex);
-		OutLocation = CandidateKeys[MinIndex];
+	if (MinIndex != INDEX_NONE) {
+		OutLocation = Grid.Locations[MinIndex];
 		return true;
 	}
 	
@@ -205,36 +1107,113 @@ FPathFindingResult ATileNavigationData::FindPath(const FNavAgentProperties& Agen
 #endif
         return ENavigationQueryResult::Error;
     }
-	if (NavGraph->TileCount == 0) {
+
+	// Queries may run on worker threads through the async path, so they only read from the published snapshot, settings
+	// included
+	FTileNavSnapshotPtr NavSnapshot = NavGraph->GetSnapshot();
+	if (!NavSnapshot.IsValid() || NavSnapshot->TileCount == 0) {
 #if WITH_EDITOR
 		UE_LOG(LogNavigation, Warning, TEXT("Navigation graph has no tiles"));
 #endif
 		return ENavigationQueryResult::Error;
 	}
-	if (NavGraph->TileNavComponents.Num() == 0) {
+	if (NavSnapshot->Grids.Num() == 0) {
 #if WITH_EDITOR
 		UE_LOG(LogNavigation, Warning, TEXT("Navigation graph has no TileNav components"));
 #endif
 		return ENavigationQueryResult::Error;
 	}
+
+	// Queries on the game thread see settings changed since the snapshot was published straight away
+	if (IsInGameThread()) {
+		const FTileNavQuerySettings Settings = NavGraph->GetQuerySettings();
+		if (NavSnapshot->Settings != Settings) {
+			TSharedRef<FTileNavSnapshot, ESPMode::ThreadSafe> UpdatedSnapshot = MakeShared<FTileNavSnapshot, ESPMode::ThreadSafe>(*NavSnapshot);
+			UpdatedSnapshot->Settings = Settings;
+			NavSnapshot = UpdatedSnapshot;
+		}
+	}
     FPathFindingResult Result(ENavigationQueryResult::Error);
-    Result.Path = Query.PathInstanceToFill.IsValid() ? Query.PathInstanceToFill : Self->CreatePathInstance<FNavigationPath>(Query);
+    Result.Path = Query.PathInstanceToFill.IsValid() ? Query.PathInstanceToFill : Self->CreatePathInstance<FTileNavPath>(Query);
     FNavigationPath* NavPath = Result.Path.Get();
 
     if (NavPath != nullptr) {
+    	if (Query.PathInstanceToFill.IsValid()) {
+    		NavPath->ResetForRepath();
+    	}
+    	FTileNavPath* TileNavPath = NavPath->CastPath<FTileNavPath>();
+    	if (TileNavPath) {
+    		TileNavPath->PathSections.Reset();
+    		TileNavPath->Repair.Reset();
+    		TileNavPath->ClusterRoute.Reset();
+    	}
         if ((Query.StartLocation - Query.EndLocation).IsNearlyZero()) {
             Result.Path->GetPathPoints().Reset();
             Result.Path->GetPathPoints().Add(FNavPathPoint(Query.EndLocation));
             Result.Result = ENavigationQueryResult::Success;
         } else if(Query.QueryFilter.IsValid()) {
         	TArray<FVector> PathTiles;
+        	TArray<int32> PathSections;
         	bool bFound = false;
-        	FindPathInternal(NavGraph, Query, bFound, PathTiles);
+        	int32 StartSection, StartTile, EndSection, EndTile;
+        	const float ClearanceRadius = AgentProperties.AgentRadius + NavSnapshot->Settings.Clearance;
+        	if (ProjectPathEnds(NavGraph, *NavSnapshot, Query, ClearanceRadius, StartSection, StartTile, EndSection, EndTile)) {
+        		FTileNavSearchStats SearchStats;
+        		const FTileNavPathCacheKey CacheKey(StartSection, StartTile, EndSection, EndTile, GetTypeHash(AgentProperties), NavSnapshot->Settings.GetPruningKey(), NavSnapshot->Settings.GetSearchKey());
+        		// Reachability follows the portal links, so stitched searches across sections are left to find out for themselves
+        		if ((StartSection == EndSection || NavSnapshot->Settings.bPortalGraphSearch) && !NavSnapshot->IsReachable(StartSection, StartTile, EndSection, EndTile)) {
+#if WITH_EDITOR
+        			if (NavSnapshot->Settings.bDisplayVerboseLogs) {
+        				UE_LOG(LogNavigation, Display, TEXT("Path rejected, start and end are in disconnected regions"));
+        			}
+#endif
+        		} else if (TileNavPath && StartSection == EndSection && FindClusterPath(NavGraph, *NavSnapshot, *TileNavPath, StartSection, StartTile, EndTile, AgentProperties, ClearanceRadius, Query.StartLocation, bFound, PathTiles, SearchStats)) {
+
+        			// Long paths through a clustered section are refined as the agent moves, so they are neither cached nor
+        			// kept for repairs
+        			PathSections.Add(StartSection);
+        		} else if (TileNavPath && NavSnapshot->Settings.bRepairActivePaths && StartSection == EndSection) {
+
+        			// Paths within one section keep their search for repairs instead of going through the cache
+        			const FTileNavGridConstPtr& Grid = NavSnapshot->Grids[StartSection];
+        			TileNavPath->Repair = MakeShared<FTileNavIncrementalSearch, ESPMode::ThreadSafe>(Grid, StartSection, StartTile, EndTile, Grid->GetClearanceLevel(ClearanceRadius));
+        			TArray<int32> PathIndices;
+        			bFound = TileNavPath->Repair->Search(SearchStats) && TileNavPath->Repair->GetPath(PathIndices);
+        			for (const int32 TileIndex: PathIndices) {
+        				PathTiles.Add(Grid->Locations[TileIndex]);
+        			}
+        			PathSections.Add(StartSection);
+        			if (PathTiles.Num() > 0 && NavSnapshot->Settings.bPathPruning) {
+        				ApplyPathPruning(NavGraph, *NavSnapshot, PathTiles, PathSections, AgentProperties, ClearanceRadius);
+        			}
+        		} else if (!NavGraph->PathCache.Find(CacheKey, NavSnapshot->SectionGenerations, PathTiles, PathSections, bFound)) {
+
+        			// Queries that project to the same tiles share a cached path until a section along it changes
+        			FindPathInternal(NavGraph, *NavSnapshot, StartSection, StartTile, EndSection, EndTile, ClearanceRadius, bFound, PathTiles, PathSections, SearchStats);
+        			if (PathTiles.Num() > 0) {
+        				if (NavSnapshot->Settings.bPathPruning) {
+        					ApplyPathPruning(NavGraph, *NavSnapshot, PathTiles, PathSections, AgentProperties, ClearanceRadius);
+        				}
+        				NavGraph->PathCache.Add(CacheKey, NavSnapshot->SectionGenerations, PathSections, PathTiles, bFound, static_cast<SIZE_T>(NavSnapshot->Settings.PathCacheSize) * 1024);
+        			}
+        		}
+#if WITH_EDITOR
+        		else if (NavSnapshot->Settings.bDisplayVerboseLogs) {
+        			UE_LOG(LogNavigation, Display, TEXT("Path served from cache"));
+        		}
+        		if (NavSnapshot->Settings.bDisplayVerboseLogs && SearchStats.Expansions > 0) {
+        			UE_LOG(LogNavigation, Display, TEXT("Tile search expanded %d tiles in %.3f ms (%.1f expansions/ms)"),
+        				SearchStats.Expansions, SearchStats.Milliseconds, SearchStats.GetExpansionsPerMillisecond());
+        		}
+#endif
+        		if (TileNavPath) {
+        			TileNavPath->PathSections = PathSections;
+        			TileNavPath->Agent = AgentProperties;
+        			TileNavPath->ClearanceRadius = ClearanceRadius;
+        		}
+        	}
 
 			if (PathTiles.Num() > 0) {
-				if (NavGraph->bPathPruning) {
-					NavGraph->ApplyPathPruning(PathTiles, AgentProperties);
-				}
 				for (auto& PathTile: PathTiles) {
 					NavPath->GetPathPoints().Add(FNavPathPoint(PathTile));
 				}
@@ -250,200 +1229,421 @@ FPathFindingResult ATileNavigationData::FindPath(const FNavAgentProperties& Agen
     return Result;
 }
 
-void ATileNavigationData::FindPathInternal(
+// Length of a path through its points, used to compare the quality of routing methods
+static float GetPathLength(const TArray<FVector>& Path) {
+	float Length = 0.0f;
+	for (int32 Index = 1; Index < Path.Num(); Index++) {
+		Length += FVector::Distance(Path[Index - 1], Path[Index]);
+	}
+	return Length;
+}
+
+bool ATileNavigationData::ProjectPathEnds(
 	const ATileNavigationData* NavGraph,
-	const FPathFindingQuery Query,
-	bool& bFound,
-	TArray<FVector>& PathTiles
+	const FTileNavSnapshot& NavSnapshot,
+	const FPathFindingQuery& Query,
+	const float ClearanceRadius,
+	int32& StartSection,
+	int32& StartTile,
+	int32& EndSection,
+	int32& EndTile
 ) {
 
-	const int32 StartSection = GetNearestSection(NavGraph, Query.StartLocation, Query.NavAgentProperties.AgentHeight);
-	
-
 	// Return early if start nav section was not found. This should only happen if the agent's feet are not on a floor mesh.
-	if (StartSection == -1) {
+	if (!NavSnapshot.FindNearestTile(Query.StartLocation, Query.NavAgentProperties.AgentHeight, StartSection, StartTile, ClearanceRadius)) {
 #if WITH_EDITOR
-		if (NavGraph->bDisplayVerboseLogs) {
+		if (NavSnapshot.Settings.bDisplayVerboseLogs) {
 			UE_LOG(LogNavigation, Warning, TEXT("Start section index invalid"));
 		}
 #endif
-		return;
+		return false;
 	}
 	
-	const int32 EndSection = GetNearestSection(NavGraph, Query.EndLocation, Query.NavAgentProperties.AgentHeight);
-	if (EndSection == -1) {
+	if (!NavSnapshot.FindNearestTile(Query.EndLocation, Query.NavAgentProperties.AgentHeight, EndSection, EndTile, ClearanceRadius)) {
 #if WITH_EDITOR
-		if (NavGraph->bDisplayVerboseLogs) {
+		if (NavSnapshot.Settings.bDisplayVerboseLogs) {
 			UE_LOG(LogNavigation, Warning, TEXT("End section index invalid"));
 		}
 #endif
+		return false;
 	}
 
-	FVector Start = NavGraph->GetNearestNavTile(GetTileNav(NavGraph, StartSection), Query.StartLocation);
-	FVector End = NavGraph->GetNearestNavTile(GetTileNav(NavGraph, EndSection), Query.EndLocation);
+#if WITH_EDITOR
+	if (NavSnapshot.Settings.bDisplayVerboseLogs) {
+		const FTileNavGrid& StartGrid = *NavSnapshot.GetGrid(StartSection);
+		double ProjectionStartTime = FPlatformTime::Seconds();
+		const int32 RingTile = StartGrid.FindNearestWalkableTile(Query.StartLocation);
+		const double RingMicroseconds = (FPlatformTime::Seconds() - ProjectionStartTime) * 1000000.0;
+		ProjectionStartTime = FPlatformTime::Seconds();
+		const int32 LinearTile = StartGrid.FindNearestWalkableTileLinear(Query.StartLocation);
+		const double LinearMicroseconds = (FPlatformTime::Seconds() - ProjectionStartTime) * 1000000.0;
+		UE_LOG(LogNavigation, Display, TEXT("Tile projection over %d tiles: ring search %.2f us, linear scan %.2f us%s"),
+			StartGrid.Num(), RingMicroseconds, LinearMicroseconds, RingTile == LinearTile ? TEXT("") : TEXT(" (equidistant tiles differ)"));
+	}
+#endif
+	return true;
+}
+
+bool ATileNavigationData::FindClusterPath(
+	const ATileNavigationData* NavGraph,
+	const FTileNavSnapshot& NavSnapshot,
+	FTileNavPath& Path,
+	const int32 Section,
+	const int32 StartTile,
+	const int32 EndTile,
+	const FNavAgentProperties& NavAgent,
+	const float ClearanceRadius,
+	const FVector& StartLocation,
+	bool& bFound,
+	TArray<FVector>& PathTiles,
+	FTileNavSearchStats& SearchStats
+) {
+
+	const FTileNavGridConstPtr& Grid = NavSnapshot.Grids[Section];
+	if (!Grid->Clusters.IsLongQuery(*Grid, StartTile, EndTile, Grid->GetClearanceLevel(ClearanceRadius))) {
+		return false;
+	}
+	TArray<int32> RouteNodes;
+	if (!Grid->Clusters.FindRoute(*Grid, StartTile, EndTile, RouteNodes, SearchStats)) {
+#if WITH_EDITOR
+		if (NavSnapshot.Settings.bDisplayVerboseLogs) {
+			UE_LOG(LogNavigation, Warning, TEXT("No cluster route found. Searching tiles instead"));
+		}
+#endif
+		return false;
+	}
+
+	// Paths with an agent to follow them are refined as it goes. Nothing refines the rest, so they are refined in full
+	const FTileNavClusterRoutePtr Route = MakeShared<FTileNavClusterRoute, ESPMode::ThreadSafe>(Grid, RouteNodes, NavSnapshot.Settings.SearchMode);
+	const bool bRefined = Path.GetQuerier() ? Route->RefineAhead(StartLocation, SearchStats) : Route->RefineAll(SearchStats);
+	if (!bRefined) {
+		return false;
+	}
+	Path.ClusterRoute = Route;
+	Path.PathSections = {Section};
+	Path.Agent = NavAgent;
+	Path.ClearanceRadius = ClearanceRadius;
+	GetClusterPathTiles(NavGraph, NavSnapshot, Path, PathTiles);
+	bFound = true;
+#if WITH_EDITOR
+	if (NavSnapshot.Settings.bDisplayVerboseLogs) {
+		UE_LOG(LogNavigation, Display, TEXT("Cluster route through %d entrances, %d of %d legs refined"),
+			RouteNodes.Num() - 2, Route->GetNumRefinedLegs(), Route->GetNumLegs());
+	}
+#endif
+	return true;
+}
+
+void ATileNavigationData::GetClusterPathTiles(const ATileNavigationData* NavGraph, const FTileNavSnapshot& NavSnapshot, const FTileNavPath& Path, TArray<FVector>& OutPathTiles) {
+	TArray<FVector> Waypoints;
+	Path.ClusterRoute->GetPath(OutPathTiles, Waypoints);
+	if (NavSnapshot.Settings.bPathPruning && OutPathTiles.Num() > 0) {
+		ApplyPathPruning(NavGraph, NavSnapshot, OutPathTiles, Path.PathSections, Path.Agent, Path.ClearanceRadius);
+	}
+	OutPathTiles.Append(Waypoints);
+}
+
+void ATileNavigationData::FindPathInternal(
+	const ATileNavigationData* NavGraph,
+	const FTileNavSnapshot& NavSnapshot,
+	const int32 StartSection,
+	const int32 StartTile,
+	const int32 EndSection,
+	const int32 EndTile,
+	const float ClearanceRadius,
+	bool& bFound,
+	TArray<FVector>& PathTiles,
+	TArray<int32>& PathSections,
+	FTileNavSearchStats& SearchStats
+) {
+
+	FVector Start = NavSnapshot.GetGrid(StartSection)->Locations[StartTile];
+	FVector End = NavSnapshot.GetGrid(EndSection)->Locations[EndTile];
 	
 	// Same nav section so find path within a single section
 	if (StartSection == EndSection) {
 #if WITH_EDITOR
-		if (NavGraph->bDisplayVerboseLogs) {
+		if (NavSnapshot.Settings.bDisplayVerboseLogs) {
 			UE_LOG(LogNavigation, Warning, TEXT("Start and end in same nav section. Finding path within single section"));
 		}
 #endif
-		GetTileNav(NavGraph, StartSection)->FindPath(Start, End, bFound, PathTiles);
+		const FTileNavGrid& Grid = *NavSnapshot.GetGrid(StartSection);
+		Grid.FindPath(Start, End, NavSnapshot.Settings.SearchMode, bFound, PathTiles, SearchStats, Grid.GetClearanceLevel(ClearanceRadius));
+		PathSections.Add(StartSection);
+#if WITH_EDITOR
+		// Search again in both directions and from the start only, to compare their expansions and latency
+		if (NavSnapshot.Settings.bDisplayVerboseLogs && Grid.IsBidirectional(StartTile, EndTile, NavSnapshot.Settings.SearchMode)) {
+			TArray<int32> ComparePath;
+			FTileNavSearchStats BidirectionalStats, UnidirectionalStats;
+			Grid.FindPath(StartTile, EndTile, NavSnapshot.Settings.SearchMode, ComparePath, BidirectionalStats, Grid.GetClearanceLevel(ClearanceRadius));
+			ComparePath.Reset();
+			Grid.FindPath(StartTile, EndTile, NavSnapshot.Settings.SearchMode, ComparePath, UnidirectionalStats, Grid.GetClearanceLevel(ClearanceRadius), false);
+			UE_LOG(LogNavigation, Display, TEXT("Bidirectional search expanded %d tiles in %.3f ms, unidirectional search %d tiles in %.3f ms"),
+				BidirectionalStats.Expansions, BidirectionalStats.Milliseconds, UnidirectionalStats.Expansions, UnidirectionalStats.Milliseconds);
+		}
+#endif
+		return;
+	}
+
+	if (!NavSnapshot.Settings.bPortalGraphSearch) {
+		FindStitchedPathInternal(NavGraph, NavSnapshot, StartSection, EndSection, Start, End, ClearanceRadius, bFound, PathTiles, PathSections, SearchStats);
 	} else {
 #if WITH_EDITOR
-		if (NavGraph->bDisplayVerboseLogs) {
-			UE_LOG(LogNavigation, Warning, TEXT("Multiple sections in path. Finding high level path across sections"));
+		if (NavSnapshot.Settings.bDisplayVerboseLogs) {
+			UE_LOG(LogNavigation, Warning, TEXT("Multiple sections in path. Finding route through the portal graph"));
 		}
+		const double PortalStartTime = FPlatformTime::Seconds();
 #endif
-		// Multiple sections so find high level path across sections
-		TArray<int32> SectionPath;
-		if (!FindSectionPathInternal(NavGraph, StartSection, EndSection, SectionPath)) {
+		if (!NavSnapshot.FindPortalPath(StartSection, StartTile, EndSection, EndTile, NavSnapshot.Settings.SearchMode, bFound, PathTiles, PathSections, SearchStats, ClearanceRadius)) {
 #if WITH_EDITOR
-			if (NavGraph->bDisplayVerboseLogs) {
-				UE_LOG(LogNavigation, Warning,TEXT("No section path found."));
+			if (NavSnapshot.Settings.bDisplayVerboseLogs) {
+				UE_LOG(LogNavigation, Warning, TEXT("No portal route found."));
 			}
 #endif
-			return;	
+			return;
 		}
 
 #if WITH_EDITOR
-		if (NavGraph->bDisplayVerboseLogs) {
-			FString SectionPathString = FString::FromInt(SectionPath[0]);
-			for (int32 Index = 1; Index < SectionPath.Num(); Index++) {
-				SectionPathString += "-->" + FString::FromInt(SectionPath[Index]);
-			}
-			UE_LOG(LogNavigation, Warning,TEXT("Section path found: %s"), *SectionPathString);
+		// Run the stitched search on the same query to compare latency and path length
+		if (NavSnapshot.Settings.bDisplayVerboseLogs) {
+			const double PortalMilliseconds = (FPlatformTime::Seconds() - PortalStartTime) * 1000.0;
+			TArray<FVector> StitchedPathTiles;
+			TArray<int32> StitchedPathSections;
+			bool bStitchedFound = false;
+			FTileNavSearchStats StitchedStats;
+			const double StitchedStartTime = FPlatformTime::Seconds();
+			FindStitchedPathInternal(NavGraph, NavSnapshot, StartSection, EndSection, Start, End, ClearanceRadius, bStitchedFound, StitchedPathTiles, StitchedPathSections, StitchedStats);
+			const double StitchedMilliseconds = (FPlatformTime::Seconds() - StitchedStartTime) * 1000.0;
+			UE_LOG(LogNavigation, Display, TEXT("Portal search %.3f ms, path length %.0f. Stitched search %.3f ms, path length %.0f%s"),
+				PortalMilliseconds, GetPathLength(PathTiles), StitchedMilliseconds, GetPathLength(StitchedPathTiles), bStitchedFound ? TEXT("") : TEXT(" (partial)"));
 		}
 #endif
+	}
 		
-		// Find initial path to the first link tile
-		FVector LinkTile;
-		if (!GetNearestEdgeTile( Start, GetTileNav(NavGraph, SectionPath[0]), GetTileNav(NavGraph, SectionPath[1]), LinkTile)) {
 #if WITH_EDITOR
-			if (NavGraph->bDisplayVerboseLogs) {
-				UE_LOG(LogNavigation, Warning,TEXT("No nearest link found for start section."));
-			}
+	if (bFound && NavSnapshot.Settings.bDisplayPaths && IsInGameThread()) {
+		for (auto& Tile: PathTiles) {
+			NavGraph->DebugDrawSphere(Tile, 20.0f, FColor::White);
+		}	
+	}
 #endif
-			return;	
-		}
+}
 
-		// Find a path to the exit link tile
-		GetTileNav(NavGraph, SectionPath[0])->FindPath(Start, LinkTile, bFound, PathTiles);
-		if (!bFound) {
+void ATileNavigationData::FindStitchedPathInternal(
+	const ATileNavigationData* NavGraph,
+	const FTileNavSnapshot& NavSnapshot,
+	const int32 StartSection,
+	const int32 EndSection,
+	const FVector Start,
+	const FVector End,
+	const float ClearanceRadius,
+	bool& bFound,
+	TArray<FVector>& PathTiles,
+	TArray<int32>& PathSections,
+	FTileNavSearchStats& SearchStats
+) {
 #if WITH_EDITOR
-			if (NavGraph->bDisplayVerboseLogs) {
-				UE_LOG(LogNavigation, Warning,TEXT("No path found for start section."));
-			}
+	if (NavSnapshot.Settings.bDisplayVerboseLogs) {
+		UE_LOG(LogNavigation, Warning, TEXT("Multiple sections in path. Finding high level path across sections"));
+	}
 #endif
-			return;
+	// Multiple sections so find high level path across sections
+	TArray<int32> SectionPath;
+	if (!FindSectionPathInternal(NavSnapshot, StartSection, EndSection, SectionPath)) {
+#if WITH_EDITOR
+		if (NavSnapshot.Settings.bDisplayVerboseLogs) {
+			UE_LOG(LogNavigation, Warning,TEXT("No section path found."));
 		}
-		
-		// Find paths between link tiles of intermediary sections
-		for (int32 Index = 1; Index < SectionPath.Num() - 1; Index++) {
+#endif
+		return;	
+	}
+	PathSections.Append(SectionPath);
 
-			// Get the nearest start tile on the next section
-			FVector SectionStart;
-			if (!GetNearestEdgeTile(LinkTile, GetTileNav(NavGraph, SectionPath[Index]), GetTileNav(NavGraph, SectionPath[Index-1]), SectionStart)) {
-				UE_LOG(LogNavigation, Warning, TEXT("No nearest link found for intermediary section."));
-				return;	
-			}
-			if (!GetNearestEdgeTile(SectionStart, GetTileNav(NavGraph, SectionPath[Index]), GetTileNav(NavGraph, SectionPath[Index+1]), LinkTile)) {
 #if WITH_EDITOR
-				if (NavGraph->bDisplayVerboseLogs) {
-					UE_LOG(LogNavigation, Warning, TEXT("No nearest link found for intermediary section."));
-				}
+	if (NavSnapshot.Settings.bDisplayVerboseLogs) {
+		FString SectionPathString = FString::FromInt(SectionPath[0]);
+		for (int32 Index = 1; Index < SectionPath.Num(); Index++) {
+			SectionPathString += "-->" + FString::FromInt(SectionPath[Index]);
+		}
+		UE_LOG(LogNavigation, Warning,TEXT("Section path found: %s"), *SectionPathString);
+	}
 #endif
-				return;	
-			}
-			GetTileNav(NavGraph, SectionPath[Index])->FindPath(SectionStart, LinkTile, bFound, PathTiles);
-			if (!bFound) {
+	
+	// Find initial path to the first link tile
+	FVector LinkTile;
+	if (!GetNearestEdgeTile(Start, *NavSnapshot.GetGrid(SectionPath[0]), SectionPath[1], LinkTile)) {
 #if WITH_EDITOR
-				if (NavGraph->bDisplayVerboseLogs) {
-					UE_LOG(LogNavigation, Warning, TEXT("No path found for intermediary section."));
-				}
+		if (NavSnapshot.Settings.bDisplayVerboseLogs) {
+			UE_LOG(LogNavigation, Warning,TEXT("No nearest link found for start section."));
+		}
 #endif
-				return;
-			}
+		return;	
+	}
+
+	// Find a path to the exit link tile
+	const FTileNavGrid& StartGrid = *NavSnapshot.GetGrid(SectionPath[0]);
+	StartGrid.FindPath(Start, LinkTile, NavSnapshot.Settings.SearchMode, bFound, PathTiles, SearchStats, StartGrid.GetClearanceLevel(ClearanceRadius));
+	if (!bFound) {
+#if WITH_EDITOR
+		if (NavSnapshot.Settings.bDisplayVerboseLogs) {
+			UE_LOG(LogNavigation, Warning,TEXT("No path found for start section."));
 		}
-		
-		// Get the nearest start tile on the final section
+#endif
+		return;
+	}
+	
+	// Find paths between link tiles of intermediary sections
+	for (int32 Index = 1; Index < SectionPath.Num() - 1; Index++) {
+
+		// Get the nearest start tile on the next section
 		FVector SectionStart;
-		if (!GetNearestEdgeTile(
-			LinkTile,
-			GetTileNav(NavGraph, SectionPath[SectionPath.Num()-1]),
-				GetTileNav(NavGraph, SectionPath[SectionPath.Num()-2]),
-				SectionStart)
-		) {
-#if WITH_EDITOR
-			if (NavGraph->bDisplayVerboseLogs) {
-				UE_LOG(LogNavigation, Warning,TEXT("No nearest link found for final section."));
+		if (!GetNearestEdgeTile(LinkTile, *NavSnapshot.GetGrid(SectionPath[Index]), SectionPath[Index-1], SectionStart)) {
+			UE_LOG(LogNavigation, Warning, TEXT("No nearest link found for intermediary section."));
+			return;	
+		}
+		if (!GetNearestEdgeTile(SectionStart, *NavSnapshot.GetGrid(SectionPath[Index]), SectionPath[Index+1], LinkTile)) {
+#if WITH_EDITOR
+			if (NavSnapshot.Settings.bDisplayVerboseLogs) {
+				UE_LOG(LogNavigation, Warning, TEXT("No nearest link found for intermediary section."));
 			}
 #endif
 			return;	
 		}
-		
-		// Find the final path section
-		GetTileNav(NavGraph, SectionPath[SectionPath.Num()-1])->FindPath(SectionStart, End, bFound, PathTiles);
+		const FTileNavGrid& Grid = *NavSnapshot.GetGrid(SectionPath[Index]);
+		Grid.FindPath(SectionStart, LinkTile, NavSnapshot.Settings.SearchMode, bFound, PathTiles, SearchStats, Grid.GetClearanceLevel(ClearanceRadius));
 		if (!bFound) {
 #if WITH_EDITOR
-			if (NavGraph->bDisplayVerboseLogs) {
-				UE_LOG(LogNavigation, Warning,TEXT("No path found for final section."));	
+			if (NavSnapshot.Settings.bDisplayVerboseLogs) {
+				UE_LOG(LogNavigation, Warning, TEXT("No path found for intermediary section."));
 			}
 #endif
 			return;
 		}
-		
-		bFound = true;
-		
+	}
+	
+	// Get the nearest start tile on the final section
+	FVector SectionStart;
+	if (!GetNearestEdgeTile(
+		LinkTile,
+		*NavSnapshot.GetGrid(SectionPath[SectionPath.Num()-1]),
+		SectionPath[SectionPath.Num()-2],
+		SectionStart)
+	) {
+#if WITH_EDITOR
+		if (NavSnapshot.Settings.bDisplayVerboseLogs) {
+			UE_LOG(LogNavigation, Warning,TEXT("No nearest link found for final section."));
+		}
+#endif
+		return;	
+	}
+	
+	// Find the final path section
+	const FTileNavGrid& EndGrid = *NavSnapshot.GetGrid(SectionPath[SectionPath.Num()-1]);
+	EndGrid.FindPath(SectionStart, End, NavSnapshot.Settings.SearchMode, bFound, PathTiles, SearchStats, EndGrid.GetClearanceLevel(ClearanceRadius));
+	if (!bFound) {
 #if WITH_EDITOR
-		if (NavGraph->bDisplayPaths) {
-			float Index = 1;
-			for (auto& Tile: PathTiles) {
-				NavGraph->DebugDrawSphere(Tile, 20.0f, FColor::White);
-				Index++;
-			}	
+		if (NavSnapshot.Settings.bDisplayVerboseLogs) {
+			UE_LOG(LogNavigation, Warning,TEXT("No path found for final section."));	
 		}
 #endif
+		return;
 	}
+	
+	bFound = true;
 }
 
-UTileNavComponent* ATileNavigationData::GetTileNav(const ATileNavigationData* NavGraph, const int32 SectionIndex) {
-	return NavGraph->TileNavComponents[NavGraph->TileNavSections[SectionIndex].SectionIndex];
+bool ATileNavigationData::FindSectionPathInternal(const FTileNavSnapshot& NavSnapshot, const int32 Start, const int32 Goal, TArray<int32> &Path) {
+	Path.Empty();
+	return NavSnapshot.SectionRoutes.IsValid() && NavSnapshot.SectionRoutes->FindRoute(Start, Goal, Path);
 }
 
-bool ATileNavigationData::FindSectionPathInternal(const ATileNavigationData* NavGraph, const int32 Start, const int32 Goal, TArray<int32> &Path) {
-	Path.Empty();
-	TArray<int32> Queue;
-	TMap<int32, int32> Visited;
-
-	Queue.Add(Start);
-	Visited.Add(Start, Start);
-
-	while (Queue.Num() > 0) {
-		int32 Current = Queue[0];
-		Queue.RemoveAt(0);
-		if (Current == Goal) {
-			int32 Breadcrumb = Current;
-			while (Breadcrumb != Start) {
-				Path.Insert(Breadcrumb, 0);
-				Breadcrumb = Visited[Breadcrumb];
+void ATileNavigationData::ApplyPathPruning(
+	const ATileNavigationData* NavGraph,
+	const FTileNavSnapshot& NavSnapshot,
+	TArray<FVector>& Path,
+	const TArray<int32>& PathSections,
+	const FNavAgentProperties NavAgent,
+	const float ClearanceRadius) {
+
+	if (Path.Num() < 3) return;
+	if (NavSnapshot.Settings.PruningMode == ETileNavPruningMode::Sweep) {
+		ApplySweepPruning(NavGraph, NavSnapshot, Path, NavAgent);
+		return;
+	}
+
+	// Path points sit on tile locations, and sections are crossed in order, so each point is matched against the
+	// section of the point before it first
+	TArray<TPair<int32, int32>> PathPointTiles;
+	int32 SectionHint = 0;
+	for (auto& Point: Path) {
+		TPair<int32, int32> PointTile(INDEX_NONE, INDEX_NONE);
+		for (int32 Offset = 0; Offset < PathSections.Num() && PointTile.Key == INDEX_NONE; Offset++) {
+			const int32 SectionIndex = PathSections[(SectionHint + Offset) % PathSections.Num()];
+			const FTileNavGrid* Grid = NavSnapshot.GetGrid(SectionIndex);
+			const int32 TileIndex = Grid ? Grid->GetTileIndex(Point) : INDEX_NONE;
+			if (TileIndex != INDEX_NONE && Grid->Locations[TileIndex].Equals(Point)) {
+				PointTile = TPair<int32, int32>(SectionIndex, TileIndex);
+				SectionHint = (SectionHint + Offset) % PathSections.Num();
 			}
-			Path.Insert(Start, 0);
-			return true;
 		}
-		for (auto& Neighbor: NavGraph->TileNavSections[Current].Neighbors) {
-			if (!Visited.Contains(Neighbor)) {
-				Queue.Push(Neighbor);
-				Visited.Add(Neighbor, Current);
+		PathPointTiles.Add(PointTile);
+	}
+	const auto HasLineOfSight = [&NavSnapshot, &PathPointTiles, ClearanceRadius](const int32 From, const int32 To) {
+		const TPair<int32, int32>& FromTile = PathPointTiles[From];
+		const TPair<int32, int32>& ToTile = PathPointTiles[To];
+		if (FromTile.Key == INDEX_NONE || FromTile.Key != ToTile.Key) {
+			return false;
+		}
+		const FTileNavGrid& Grid = *NavSnapshot.GetGrid(FromTile.Key);
+		return Grid.HasLineOfSight(FromTile.Value, ToTile.Value, Grid.GetClearanceLevel(ClearanceRadius));
+	};
+
+	// Keep the last point in sight of the current anchor each time the next one drops out of sight
+	TArray<int32> PrunedIndices = {0};
+	for (int32 Index = 2; Index < Path.Num(); Index++) {
+		if (!HasLineOfSight(PrunedIndices.Last(), Index)) {
+			PrunedIndices.Add(Index - 1);
+		}
+	}
+	PrunedIndices.Add(Path.Num() - 1);
+
+	// Optionally confirm each shortcut with a single sweep, restoring the original points of any that are blocked
+	UWorld* World = NavGraph->GetWorld();
+	TArray<FVector> PrunedPath;
+	PrunedPath.Add(Path[0]);
+	for (int32 Index = 1; Index < PrunedIndices.Num(); Index++) {
+		const int32 From = PrunedIndices[Index - 1];
+		const int32 To = PrunedIndices[Index];
+		if (NavSnapshot.Settings.bValidatePrunedPaths && World && To - From > 1) {
+			FHitResult HitResult;
+			World->SweepSingleByChannel(
+				HitResult,
+				Path[From],
+				Path[To],
+				FQuat::Identity,
+				ECollisionChannel::ECC_WorldStatic,
+				FCollisionShape::MakeSphere(NavAgent.AgentRadius),
+				NavSnapshot.PruningQueryParams
+			);
+			if (HitResult.bBlockingHit) {
+				for (int32 PointIndex = From + 1; PointIndex < To; PointIndex++) {
+					PrunedPath.Add(Path[PointIndex]);
+				}
 			}
 		}
+		PrunedPath.Add(Path[To]);
 	}
-	return false;
+	Path = PrunedPath;
 }
 
-void ATileNavigationData::ApplyPathPruning(TArray<FVector>& Path, const FNavAgentProperties NavAgent) const {
-	if (!GetWorld() || Path.Num() < 3) return;
+void ATileNavigationData::ApplySweepPruning(
+	const ATileNavigationData* NavGraph,
+	const FTileNavSnapshot& NavSnapshot,
+	TArray<FVector>& Path,
+	const FNavAgentProperties NavAgent) {
+
+	UWorld* World = NavGraph->GetWorld();
+	if (!World || Path.Num() < 3) return;
 	TArray<FVector> PrunedPath;
 	PrunedPath.Add(Path[0]);
 	int32 CurrentPoint = 0;
@@ -455,27 +1655,19 @@ void ATileNavigationData::ApplyPathPruning(TArray<FVector>& Path, const FNavAgen
 				CurrentPoint = Path.Num();
 				break;
 			}
-			FCollisionQueryParams CollisionQueryParams;
-			CollisionQueryParams.bTraceComplex = false;
-			CollisionQueryParams.TraceTag = "TileNavPathPrune";
-			for (auto& TileNavComponent: TileNavComponents) {
-				CollisionQueryParams.AddIgnoredComponent(TileNavComponent);
-				CollisionQueryParams.AddIgnoredComponents(TileNavComponent->IgnoreComponents);
-			}
-			
 			FHitResult HitResult;
 			FVector Start = Path[CurrentPoint];
 			FVector End = Path[Index+2];
 
 			// Use a sphere with nav agent radius to check clearance during line-of-sight checks
-			GetWorld()->SweepSingleByChannel(
+			World->SweepSingleByChannel(
                 HitResult,
                 Start,
                 End,
                 FQuat::Identity,
                 ECollisionChannel::ECC_WorldStatic,
                 FCollisionShape::MakeSphere(NavAgent.AgentRadius),
-                CollisionQueryParams
+                NavSnapshot.PruningQueryParams
             );
 			
 			if (HitResult.bBlockingHit) {
@@ -494,7 +1686,7 @@ void ATileNavigationData::PostEditChangeProperty(struct FPropertyChangedEvent& P
 	FProperty* Property = PropertyChangedEvent.Property;
 	const FString PropertyName = Property != nullptr ? Property->GetFName().ToString() : "";
 
-	const TSet<FString> DebugProperties = {
+	const TSet<FString> BuildProperties = {
 		"ComponentProximity",
 		"TileProximity",
 		"GridScale",
@@ -504,8 +1696,12 @@ void ATileNavigationData::PostEditChangeProperty(struct FPropertyChangedEvent& P
 		"bDisplayLinkage",
 		"bDisplayTiles",
         "bDisplayPaths",
+		"NumLandmarks",
+		"ClusterSize",
+		"MinClusteredTiles",
+		"BidirectionalSearchDistance",
 	};
-	if (DebugProperties.Contains(PropertyName)) {
+	if (BuildProperties.Contains(PropertyName)) {
 		RebuildAll();
 		DebugDrawTileNav();
 	}
@@ -517,32 +1713,34 @@ void ATileNavigationData::DebugDrawTileNav() {
 		return;
 	}
 	for (auto& NavSection: TileNavSections) {
+		if (!TileNavComponents[NavSection.SectionIndex]) {
+			continue;
+		}
 		if (bDisplaySections) {
 			DebugDrawNumeric(
 				TileNavComponents[NavSection.SectionIndex]->GetComponentLocation() + TileNavComponents[NavSection.SectionIndex]->GetUpVector()*100.f,
 				FString::FromInt(TileNavComponents[NavSection.SectionIndex]->SectionIndex),
 				FColor::Red);
 		}
-		for (auto& Tile: TileNavComponents[NavSection.SectionIndex]->Tiles) {
-			const bool bEdgeTile = TileNavComponents[NavSection.SectionIndex]->EdgeTiles.Contains(Tile.Key);
+		const FTileNavGrid& Grid = *TileNavComponents[NavSection.SectionIndex]->Grid;
+		for (int32 TileIndex = 0; TileIndex < Grid.Num(); TileIndex++) {
+			if (!Grid.IsValidTile(TileIndex)) {
+				continue;
+			}
+			const FVector& TileLocation = Grid.Locations[TileIndex];
+			const FEdgeNeighbors* EdgeTile = Grid.EdgeTiles->Find(TileIndex);
 			if (bDisplayTiles) {
-				DebugDrawBox(Tile.Key, FVector(TileNavComponents[NavSection.SectionIndex]->GridSize * GridScale * 0.5f), bEdgeTile ? FColor::Orange : FColor::Cyan);
+				DebugDrawBox(TileLocation, FVector(TileNavComponents[NavSection.SectionIndex]->GridSize * GridScale * 0.5f), EdgeTile ? FColor::Orange : FColor::Cyan);
 			}
-			if (bEdgeTile) {
-				if (TileNavComponents[NavSection.SectionIndex]->EdgeTiles[Tile.Key].NavSections.Num() > 0) {
-					if (bDisplayLinkage) {
-						FString Numeric= "";
-						for (int32 Index = 0; Index < TileNavComponents[NavSection.SectionIndex]->EdgeTiles[Tile.Key].NavSections.Num(); Index++ ) {
-							DebugDrawNumeric(
-								Tile.Key + FVector(0,0,100.f + 100.0f * Index ),
-								FString::FromInt(TileNavComponents[NavSection.SectionIndex]->EdgeTiles[Tile.Key].NavSections[Index]),
-								FColor::Yellow
-							);
-						}
-					}
+			if (EdgeTile && EdgeTile->NavSections.Num() > 0 && bDisplayLinkage) {
+				for (int32 Index = 0; Index < EdgeTile->NavSections.Num(); Index++ ) {
+					DebugDrawNumeric(
+						TileLocation + FVector(0,0,100.f + 100.0f * Index ),
+						FString::FromInt(EdgeTile->NavSections[Index]),
+						FColor::Yellow
+					);
 				}
 			}
-			
 		}
 	}
 }
@@ -0,0 +1,45 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "TileNavStructs.h"
+#include "TileNavSnapshot.h"
+
+/**
+ * Route through the clusters of a section, found on the cluster entrance graph and refined into tiles one leg at a
+ * time, so that only the clusters an agent is about to enter are ever searched tile by tile. Keeps the grid it was
+ * planned on alive. Only safe to use from one thread at a time.
+ */
+class TILENAV_API FTileNavClusterRoute {
+public:
+
+	// Nodes run from the start tile to the end tile, through the entrances found by FTileNavClusters::FindRoute
+	FTileNavClusterRoute(const FTileNavGridConstPtr& InGrid, const TArray<int32>& InNodes, ETileNavSearchMode InMode);
+
+	// Refine legs until the refined tiles end at least two clusters away from Location, or the route is fully refined.
+	// Returns false if a leg could not be found, after which the route cannot be refined any further
+	bool RefineAhead(const FVector& Location, FTileNavSearchStats& Stats);
+
+	// Refine every remaining leg
+	bool RefineAll(FTileNavSearchStats& Stats);
+
+	// Locations of the tiles refined so far, and of the route nodes beyond them
+	void GetPath(TArray<FVector>& OutRefinedTiles, TArray<FVector>& OutWaypoints) const;
+
+	FORCEINLINE bool IsRefined() const { return RefinedNodes == Nodes.Num(); }
+	FORCEINLINE int32 GetNumLegs() const { return Nodes.Num() - 1; }
+	FORCEINLINE int32 GetNumRefinedLegs() const { return RefinedNodes - 1; }
+	FORCEINLINE const FTileNavGridConstPtr& GetGrid() const { return Grid; }
+
+private:
+	FTileNavGridConstPtr Grid;
+	TArray<int32> Nodes;
+	ETileNavSearchMode Mode;
+
+	// Nodes reached by the refined tiles, the start included
+	int32 RefinedNodes;
+	TArray<int32> Tiles;
+	bool bFailed;
+
+	bool RefineNext(FTileNavSearchStats& Stats);
+};
+
+typedef TSharedPtr<FTileNavClusterRoute, ESPMode::ThreadSafe> FTileNavClusterRoutePtr;
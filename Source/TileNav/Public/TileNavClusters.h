@@ -0,0 +1,79 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "TileNavStructs.h"
+
+struct FTileNavGrid;
+
+// A square block of tiles in a section, with the entrances on its borders and the walkable distances between them
+struct TILENAV_API FTileNavCluster {
+
+	// Pairs of adjacent walkable tiles across the east and south borders, with the tile in this cluster first
+	TArray<FIntPoint> EastEntrances;
+	TArray<FIntPoint> SouthEntrances;
+
+	// Entrance tiles on every border of the cluster, and the walkable distance between each pair of them by node index,
+	// moving only over the cluster's own tiles. Pairs that cannot reach each other within the cluster cost MAX_FLT
+	TArray<int32> Nodes;
+	TArray<float> Costs;
+
+	FORCEINLINE float GetCost(const int32 FromNode, const int32 ToNode) const { return Costs[FromNode * Nodes.Num() + ToNode]; }
+};
+
+/**
+ * Divides a large section into fixed-size clusters for hierarchical search. Long queries are searched over the graph
+ * of cluster entrances, whose edges are the precomputed distances across each cluster and the single steps between
+ * neighboring clusters, and are only refined into tiles leg by leg. Entrances and distances are found for the smallest
+ * agent, and are rebuilt locally around the clusters whose tiles change.
+ */
+struct TILENAV_API FTileNavClusters {
+
+	// Entrance runs at least this many tiles wide get an entrance at each end rather than one in the middle
+	static const int32 WideEntrance = 6;
+
+	// Tiles along each side of a cluster, zero when the section is not clustered
+	int32 ClusterSize;
+	int32 ClustersX;
+	int32 ClustersY;
+
+	// World distance across a cluster, used to judge how far ahead of the agent to refine
+	float ClusterExtent;
+
+	TArray<FTileNavCluster> Clusters;
+
+	FTileNavClusters();
+
+	// Divide the grid into clusters of InClusterSize tiles along each side and build every cluster. Zero clears them
+	void Build(const FTileNavGrid& Grid, int32 InClusterSize);
+	void Reset();
+
+	// Rebuild the entrances around the clusters holding ChangedTiles, then the nodes and costs of those clusters and
+	// their neighbors, whose entrances they share
+	void Update(const FTileNavGrid& Grid, const TArray<int32>& ChangedTiles);
+
+	FORCEINLINE bool IsEnabled() const { return Clusters.Num() > 0; }
+	int32 GetCluster(const FTileNavGrid& Grid, int32 TileIndex) const;
+
+	// Whether a query between two tiles is long enough to search over clusters, with its ends more than a cluster
+	// apart. Clusters are built for the smallest agent, so agents needing extra clearance always search tiles
+	bool IsLongQuery(const FTileNavGrid& Grid, int32 StartIndex, int32 EndIndex, uint8 MinClearance) const;
+
+	// Search the entrance graph for a route between two tiles, appending the start, the entrances passed through and
+	// the end to OutRoute. Fails when the entrances miss a crossing between clusters, such as a lone diagonal step
+	// through a corner, so callers should fall back to searching tiles
+	bool FindRoute(const FTileNavGrid& Grid, int32 StartIndex, int32 EndIndex, TArray<int32>& OutRoute, FTileNavSearchStats& Stats) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	void BuildEntrances(const FTileNavGrid& Grid, int32 Cluster);
+	void BuildNodes(const FTileNavGrid& Grid, int32 Cluster);
+
+	// Tiles reached across the borders of the cluster from one of its nodes
+	void GetCrossings(int32 Cluster, int32 NodeTile, TArray<int32>& OutTiles) const;
+
+	// Walkable distance from a tile of the cluster to each of its nodes, moving only over the cluster's own tiles
+	void ComputeNodeDistances(const FTileNavGrid& Grid, int32 Cluster, int32 StartIndex, TArray<float>& OutDistances, FTileNavSearchStats& Stats) const;
+};
+
+TILENAV_API FArchive& operator<<(FArchive& Ar, FTileNavCluster& Cluster);
+TILENAV_API FArchive& operator<<(FArchive& Ar, FTileNavClusters& Clusters);
@@ -1,10 +1,13 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "TileNavStructs.h"
+#include "TileNavGrid.h"
 #include "Components/ArrowComponent.h"
 
 #include "TileNavComponent.generated.h"
 
+class ATileNavigationData;
+
 UCLASS( ClassGroup=(TileNav), meta=(BlueprintSpawnableComponent) )
 class TILENAV_API UTileNavComponent final : public UStaticMeshComponent {
 
@@ -14,18 +17,25 @@ public:
 	UTileNavComponent(const FObjectInitializer& ObjectInitializer);
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	virtual void OnComponentCreated() override;
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+	virtual bool SetStaticMesh(UStaticMesh* NewMesh) override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 	
 	UPROPERTY()
 	UArrowComponent* CollisionTraceNormalArrow;
 	
 	UPROPERTY()
-	int32 SectionIndex;
+	int32 SectionIndex = INDEX_NONE;
 	
-	UPROPERTY()
-	TMap<FVector, FTileNavTile> Tiles;
+	// Dense tile storage for this section. A new grid is created by each build and by each tile update, since
+	// published navigation snapshots may still be reading the previous one from worker threads
+	TSharedPtr<FTileNavGrid, ESPMode::ThreadSafe> Grid;
 
-	UPROPERTY()
-	TMap<FVector, FEdgeNeighbors> EdgeTiles;
+	// Navigation data that owns this section, notified whenever the tiles change
+	TWeakObjectPtr<ATileNavigationData> NavigationData;
 
 	UPROPERTY()
 	TArray<UPrimitiveComponent*> IgnoreComponents;
@@ -38,9 +48,30 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "TileNav")
 	FRotator CollisionTraceNormal = FRotator::ZeroRotator;
 	
-    void BuildNavigationTiles(float GridScale, float Clearance);
+	// Build the tile grid for this section. Scene queries are distributed across worker threads by row when bParallel
+	// is set, and the result is merged in row-major order so it is identical to a serial build. Tiles with at least
+	// WalkableClearance are walkable, and clearances are measured exactly up to MaxClearance
+    void BuildNavigationTiles(float GridScale, float WalkableClearance, float MaxClearance, bool bParallel, FTileNavBuildStats& BuildStats);
     void GetCollisionBounds(FBox& CollisionBounds) const;
 
+	// Measure the clearance of every tile from obstacles overlapping the component, found with one overlap query and
+	// rasterized into cells for a distance transform, instead of one sphere overlap per tile
+	void BuildTileClearances(const TArray<bool>& SurfaceTiles, float ClearanceRadius, bool bParallel, TArray<float>& OutClearances);
+
+	// Queue this section for an incremental rebuild. Called automatically when the transform or mesh changes, or when
+	// the component is registered or unregistered, e.g. by level streaming
+	UFUNCTION(BlueprintCallable, Category = "TileNav")
+	void MarkNavigationDirty();
+
+	UFUNCTION(BlueprintCallable, Category = "TileNav")
+	void SetGridSize(float NewGridSize);
+
+	UFUNCTION(BlueprintCallable, Category = "TileNav")
+	void SetCollisionTraceNormal(FRotator NewCollisionTraceNormal);
+
+	UFUNCTION(BlueprintCallable, Category = "TileNav")
+	void SetIgnoreComponents(const TArray<UPrimitiveComponent*>& NewIgnoreComponents);
+
 	UFUNCTION(BlueprintCallable, Category = "TileNav")
 	bool UpdateTile(FVector Tile, bool bWalkable);
 
@@ -49,4 +80,10 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "TileNav")
 	void FindPath(const FVector Start, const FVector End, bool &bFound, TArray<FVector> &PathTiles);
+
+	// Search between two tiles, appending the path to PathTiles and accumulating search counters into Stats
+	void FindPathWithStats(const FVector Start, const FVector End, ETileNavSearchMode SearchMode, bool &bFound, TArray<FVector> &PathTiles, FTileNavSearchStats& Stats) const;
+
+protected:
+	virtual void OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport = ETeleportType::None) override;
 };
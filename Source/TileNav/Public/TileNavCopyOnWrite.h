@@ -0,0 +1,43 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Container shared between copies of a grid until one of them edits it. Grids are copied whenever their tiles are
+ * updated, since published snapshots may still be reading the old one, so data an update leaves untouched is shared
+ * rather than copied. Reads go straight to the shared container. Edit takes a copy of its own first if any other grid
+ * still shares it, so it must only be called on a grid that has not been published.
+ */
+template<typename ContainerType>
+class TTileNavCopyOnWrite {
+public:
+	TTileNavCopyOnWrite(): Container(MakeShared<ContainerType, ESPMode::ThreadSafe>()) {}
+
+	FORCEINLINE const ContainerType& Get() const { return Container.Get(); }
+	FORCEINLINE const ContainerType* operator->() const { return &Container.Get(); }
+
+	template<typename KeyType>
+	FORCEINLINE decltype(auto) operator[](const KeyType& Key) const { return Get()[Key]; }
+
+	FORCEINLINE auto begin() const { return Get().begin(); }
+	FORCEINLINE auto end() const { return Get().end(); }
+
+	ContainerType& Edit() {
+		if (!Container.IsUnique()) {
+			Container = MakeShared<ContainerType, ESPMode::ThreadSafe>(Container.Get());
+		}
+		return Container.Get();
+	}
+
+	// Start again from an empty container of its own, leaving any other grid's copy untouched
+	void Empty() {
+		Container = MakeShared<ContainerType, ESPMode::ThreadSafe>();
+	}
+
+	// Saving only reads the container, so only loading takes a copy of its own
+	ContainerType& GetForSerialize(const FArchive& Ar) {
+		return Ar.IsLoading() ? Edit() : Container.Get();
+	}
+
+private:
+	TSharedRef<ContainerType, ESPMode::ThreadSafe> Container;
+};
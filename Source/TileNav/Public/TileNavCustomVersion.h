@@ -0,0 +1,39 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Misc/Guid.h"
+
+// Version of the baked navigation data saved with TileNavigationData actors
+struct TILENAV_API FTileNavCustomVersion {
+	enum Type {
+		BeforeCustomVersionWasAdded = 0,
+
+		// Section grids, edge links and the build checksum are saved with the level
+		BakedNavigationData,
+
+		// Section grids include their portals and portal costs
+		PortalGraph,
+
+		// Section grids include the walkable distance from their center to each portal
+		SectionRouting,
+
+		// Section grids include the clearance of each tile
+		TileClearance,
+
+		// Tile clearances are quantized to a byte, and saved with the clearance walkable tiles were built with
+		QuantizedClearance,
+
+		// Section grids include landmark distances for the ALT heuristic
+		Landmarks,
+
+		// Section grids include their clusters for hierarchical search
+		Clusters,
+
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	static const FGuid GUID;
+
+private:
+	FTileNavCustomVersion() {}
+};
@@ -0,0 +1,99 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "TileNavStructs.h"
+#include "TileNavSnapshot.h"
+
+// A step from a tile to a tile of another section, across linked edge tiles
+struct TILENAV_API FTileNavFlowLink {
+	int32 Section;
+	int32 Tile;
+	float Cost;
+
+	FTileNavFlowLink(): Section(INDEX_NONE), Tile(INDEX_NONE), Cost(0.0f) {}
+	FTileNavFlowLink(const int32 InSection, const int32 InTile, const float InCost): Section(InSection), Tile(InTile), Cost(InCost) {}
+};
+
+/**
+ * Distance and next step towards a shared goal for every tile that can reach it, across all linked sections.
+ * The field is integrated once with Dijkstra from the goal, after which any number of agents can sample it
+ * without searching. Built against a single snapshot, and only safe to use from one thread at a time.
+ */
+class TILENAV_API FTileNavFlowField {
+public:
+
+	// Tile direction values beyond the eight grid directions
+	static const uint8 GoalDirection = 8;
+	static const uint8 LinkDirection = 9;
+	static const uint8 Unreached = MAX_uint8;
+
+	FTileNavFlowField();
+
+	// Integrate the field outward from the goal tile. Edge tiles are linked to the nearest walkable tile of each
+	// section they link to, if it is within MaxLinkDistance
+	void Build(const FTileNavSnapshotPtr& InSnapshot, int32 InGoalSection, int32 InGoalTile, float InMaxLinkDistance);
+
+	// Move the goal to another tile reachable from the current goal. Distances to the new goal are bounded by the
+	// old distances plus the distance between the two goals, so only the tiles those bounds overestimate are
+	// revisited. Rebuilds from scratch if the new goal cannot be reached from the old one
+	void MoveGoal(int32 NewGoalSection, int32 NewGoalTile);
+
+	// Whether the field was built on the same grids as the snapshot, so that it can carry on being used with it
+	bool IsCurrent(const FTileNavSnapshot& OtherSnapshot) const;
+
+	// Adopt a snapshot with the same grids, for example one published after an unrelated change
+	void SetSnapshot(const FTileNavSnapshotPtr& InSnapshot) { Snapshot = InSnapshot; }
+
+	FORCEINLINE float GetDistance(const int32 Section, const int32 Tile) const {
+		return Fields.IsValidIndex(Section) && Fields[Section].Distances.IsValidIndex(Tile) ? Fields[Section].Distances[Tile] : MAX_FLT;
+	}
+
+	// The tile to move to from a tile. Returns false at the goal and for tiles that cannot reach it
+	bool GetNextTile(int32 Section, int32 Tile, int32& OutSection, int32& OutTile) const;
+
+	// Direction to move from Location, and its remaining distance to the goal. InOutSection is a hint for the section
+	// under the location: when the location is on a tile of that section the sample is constant time, otherwise the
+	// nearest section within SearchRadius is found and written back. The direction is zero at the goal tile
+	bool Sample(const FVector& Location, float SearchRadius, int32& InOutSection, FVector& OutDirection, float& OutDistance) const;
+
+	FORCEINLINE int32 GetGoalSection() const { return GoalSection; }
+	FORCEINLINE int32 GetGoalTile() const { return GoalTile; }
+	FORCEINLINE const FTileNavSnapshotPtr& GetSnapshot() const { return Snapshot; }
+
+	// Counters from the most recent build or goal move
+	FORCEINLINE const FTileNavSearchStats& GetStats() const { return Stats; }
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FSectionField {
+		TArray<float> Distances;
+		TArray<uint8> Directions;
+
+		// Next tile for tiles whose next step crosses into another section
+		TMap<int32, FTileNavFlowLink> Exits;
+	};
+
+	struct FOpenTile {
+		int32 Section;
+		int32 Tile;
+		float Distance;
+	};
+
+	FTileNavSnapshotPtr Snapshot;
+	int32 GoalSection;
+	int32 GoalTile;
+	float MaxLinkDistance;
+	TArray<FSectionField> Fields;
+
+	// Cross-section steps from each linked edge tile, by section, in both directions
+	TArray<TMap<int32, TArray<FTileNavFlowLink>>> Links;
+
+	FTileNavSearchStats Stats;
+
+	void BuildLinks();
+	FSectionField& GetField(int32 Section);
+	bool Relax(TArray<FOpenTile>& Open, int32 Section, int32 Tile, float Distance, uint8 Direction, const FTileNavFlowLink* Exit = nullptr);
+	void Integrate(TArray<FOpenTile>& Open);
+};
+
+typedef TSharedPtr<FTileNavFlowField, ESPMode::ThreadSafe> FTileNavFlowFieldPtr;
@@ -0,0 +1,266 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "TileNavStructs.h"
+#include "TileNavClusters.h"
+#include "TileNavCopyOnWrite.h"
+
+namespace ETileNavTileFlags {
+	enum Type : uint8 {
+		None = 0,
+
+		// Set for every grid cell that produced a navigation tile during the build
+		Valid = 1 << 0,
+
+		// Cleared by UpdateTile(s) when gameplay blocks a tile
+		Walkable = 1 << 1,
+	};
+}
+
+// A contiguous run of edge tiles linked to the same neighboring section, entered and left through its center tile
+struct TILENAV_API FTileNavPortal {
+	int32 TileIndex;
+	int32 TargetSection;
+
+	FTileNavPortal(): TileIndex(INDEX_NONE), TargetSection(INDEX_NONE) {}
+	FTileNavPortal(const int32 InTileIndex, const int32 InTargetSection): TileIndex(InTileIndex), TargetSection(InTargetSection) {}
+};
+
+FORCEINLINE FArchive& operator<<(FArchive& Ar, FTileNavPortal& Portal) {
+	Ar << Portal.TileIndex;
+	Ar << Portal.TargetSection;
+	return Ar;
+}
+
+/**
+ * Dense tile storage for a single TileNav section. Tiles are addressed by (X, Y) grid coordinates and
+ * stored row-major in contiguous arrays, so lookups never hash and neighbor iteration stays cache-friendly.
+ * Grid space is the component's local space rotated by its collision trace normal.
+ */
+struct TILENAV_API FTileNavGrid {
+
+	// Grid offsets for each neighbor direction, in neighbor mask bit order. Odd directions are diagonals
+	static const FIntPoint DirectionOffsets[8];
+
+	// Quantized clearance steps per tile spacing. Clearances saturate at 255 steps, well beyond any agent size
+	static const int32 ClearanceStepsPerTile = 4;
+
+	int32 Width;
+	int32 Height;
+
+	// Number of valid tiles in the grid
+	int32 NumTiles;
+
+	// Grid space origin of tile (0, 0) and the spacing between tiles, both in component local units
+	FVector2D Origin;
+	float Interval;
+
+	FTransform ComponentTransform;
+	FQuat TraceRotation;
+
+	// Index offsets for each neighbor direction, matching DirectionOffsets for this grid's width
+	int32 NeighborOffsets[8];
+
+	// Data fixed when the grid is built or linked is shared with the grid's copies, as updating tiles only changes
+	// their flags and what is derived from them
+	TTileNavCopyOnWrite<TArray<FVector>> Locations;
+	TArray<uint8> Flags;
+	TTileNavCopyOnWrite<TArray<uint8>> NeighborMasks;
+
+	// Distance from each tile to the nearest obstacle when the grid was built, in steps of ClearanceStep world units
+	// rounded down, so that one byte per tile serves every agent size. Zero for tiles that are not walkable
+	TTileNavCopyOnWrite<TArray<uint8>> Clearances;
+	float ClearanceStep;
+
+	// Clearance every walkable tile was built with. Agents needing no more than this skip the clearance test
+	float WalkableClearance;
+
+	// Tiles on the boundary of the grid, keyed by tile index, along with the sections they link to
+	TTileNavCopyOnWrite<TMap<int32, FEdgeNeighbors>> EdgeTiles;
+
+	// World bounds of the valid tile locations
+	FBox TileBounds;
+
+	// 8-connected region of each walkable tile, INDEX_NONE for the rest, and the number of tiles in each region by
+	// label. Labels are found for the smallest agent and kept up to date by SetWalkable. Labels retired by merges and
+	// splits keep a size of zero until the labels are next rebuilt
+	TArray<int32> Regions;
+	TArray<int32> RegionSizes;
+
+	// Landmark tiles for the ALT heuristic, and the walkable distance from every landmark to each tile, stored per tile
+	// for all landmarks together in steps of LandmarkStep world units rounded down. MAX_uint16 marks tiles a landmark
+	// cannot reach. Empty when landmarks are disabled
+	TArray<int32> Landmarks;
+	TTileNavCopyOnWrite<TArray<uint16>> LandmarkDistances;
+	float LandmarkStep;
+
+	// Straight line distance beyond which A* searches run from both ends at once. Taken from the navigation settings
+	// rather than saved with the grid. MAX_FLT disables
+	float BidirectionalDistance;
+
+	// Clusters for hierarchical search of long queries. Empty unless the section is large enough to be clustered
+	FTileNavClusters Clusters;
+
+	// Portals into neighboring sections, and the walkable distance between each pair of them by portal index. Pairs
+	// that cannot reach each other within this section cost MAX_FLT
+	TArray<FTileNavPortal> Portals;
+	TArray<float> PortalCosts;
+
+	// Walkable tile nearest the middle of the section, and the walkable distance from it to each portal. Used to weigh
+	// the links between sections by the distance travelled across them
+	int32 CenterTile;
+	TArray<float> CenterPortalCosts;
+
+	FTileNavGrid();
+
+	void Init(int32 InWidth, int32 InHeight, const FTransform& InComponentTransform, const FQuat& InTraceRotation, const FVector2D& InOrigin, float InInterval);
+	void Reset();
+
+	// Set the neighbor mask of every valid tile from its valid 8-connected neighbors
+	void BuildNeighborMasks();
+
+	void UpdateTileBounds();
+
+	// Group the linked edge tiles into portals and compute the cost between every pair of them. Must be run again
+	// whenever edge links or walkability change
+	void BuildPortals();
+
+	FORCEINLINE float GetPortalCost(const int32 FromPortal, const int32 ToPortal) const { return PortalCosts[FromPortal * Portals.Num() + ToPortal]; }
+
+	// Cost of travelling from the center of the section to its cheapest portal into TargetSection, or MAX_FLT if there
+	// is none. Portals cut off from the center fall back to their straight-line distance
+	float GetCenterCost(int32 TargetSection, int32& OutPortal) const;
+	FVector GetCenterLocation() const;
+
+	// Walkable distance from a tile to every portal, using the same moves and costs as the A* search. Stops as soon as
+	// every portal has been reached. Unreachable portals are MAX_FLT
+	void ComputePortalDistances(int32 StartIndex, TArray<float>& OutDistances, FTileNavSearchStats& Stats, uint8 MinClearance = 0) const;
+
+	FORCEINLINE int32 Num() const { return Width * Height; }
+	FORCEINLINE int32 GetIndex(const int32 X, const int32 Y) const { return Y * Width + X; }
+	FORCEINLINE FIntPoint GetCoord(const int32 Index) const { return FIntPoint(Index % Width, Index / Width); }
+	FORCEINLINE bool IsInBounds(const int32 X, const int32 Y) const { return X >= 0 && Y >= 0 && X < Width && Y < Height; }
+	FORCEINLINE bool IsValidTile(const int32 Index) const { return Flags.IsValidIndex(Index) && (Flags[Index] & ETileNavTileFlags::Valid); }
+	FORCEINLINE bool IsWalkable(const int32 Index, const uint8 MinClearance = 0) const {
+		return (Flags[Index] & (ETileNavTileFlags::Valid | ETileNavTileFlags::Walkable)) == (ETileNavTileFlags::Valid | ETileNavTileFlags::Walkable) &&
+			(MinClearance == 0 || Clearances[Index] >= MinClearance);
+	}
+	FORCEINLINE bool IsWalkableAt(const int32 X, const int32 Y, const uint8 MinClearance = 0) const { return IsInBounds(X, Y) && IsWalkable(GetIndex(X, Y), MinClearance); }
+
+	// Quantized clearance a tile needs to fit an agent needing Radius clearance, for the MinClearance parameters of
+	// the walkability tests and searches. Zero when every walkable tile already fits it
+	uint8 GetClearanceLevel(float Radius) const;
+	FORCEINLINE float GetClearance(const int32 Index) const { return Clearances[Index] * ClearanceStep; }
+
+	// Store a clearance in world units, rounding down to the step below
+	void SetClearance(int32 Index, float Clearance);
+
+	// Continuous grid coordinates of a world location, where integer values fall on tile centers
+	FVector2D WorldToGrid(const FVector& Location) const;
+
+	// World location at continuous grid coordinates, Depth local units along the trace direction
+	FVector GridToWorld(float X, float Y, float Depth) const;
+
+	// Local depth of a world location along the trace direction
+	float GetDepth(const FVector& Location) const;
+
+	// Replace squared distances in a Width by Height grid with the squared Euclidean distance to the nearest zero,
+	// using separable exact transforms over columns then rows. Unreachable cells should start at a large finite value
+	static void ComputeDistanceTransform(TArray<float>& SquaredDistances, int32 Width, int32 Height, bool bParallel);
+
+	// Index of the valid tile whose grid cell contains the location, or INDEX_NONE
+	int32 GetTileIndex(const FVector& Location) const;
+
+	// Index of the walkable tile nearest to the location, or INDEX_NONE. Searches outward in rings from the tile under
+	// the location and stops once no further ring can hold a closer tile
+	int32 FindNearestWalkableTile(const FVector& Location, uint8 MinClearance = 0) const;
+
+	// Reference implementation of FindNearestWalkableTile that checks every tile, kept for benchmarking
+	int32 FindNearestWalkableTileLinear(const FVector& Location) const;
+
+	// Set whether a tile is walkable, joining or splitting the regions around it when the tile changes
+	bool SetWalkable(int32 Index, bool bWalkable);
+
+	// Label every walkable tile with its region from scratch
+	void BuildRegions();
+
+	// Choose up to NumLandmarks tiles across the largest region, each as far as possible from those before it, and
+	// store the walkable distance from each of them to every tile. Distances are found for the smallest agent, so
+	// blocking tiles keeps them admissible but unblocking tiles needs them built again
+	void BuildLandmarks(int32 NumLandmarks);
+
+	// Divide the grid into clusters of ClusterSize tiles along each side, if it has at least MinTiles tiles. Otherwise,
+	// or if ClusterSize is zero, the grid is left unclustered
+	void BuildClusters(int32 ClusterSize, int32 MinTiles);
+
+	// Lower bound on the walkable distance between two tiles. With landmarks, the triangle inequality bound from the
+	// landmark distances, less a step for rounding, is used wherever it beats the straight line distance
+	FORCEINLINE float GetHeuristic(const int32 FromIndex, const int32 ToIndex) const {
+		const float Distance = FVector::Distance(Locations[FromIndex], Locations[ToIndex]);
+		const int32 NumLandmarks = Landmarks.Num();
+		if (NumLandmarks == 0) {
+			return Distance;
+		}
+		const uint16* FromDistances = &LandmarkDistances[FromIndex * NumLandmarks];
+		const uint16* ToDistances = &LandmarkDistances[ToIndex * NumLandmarks];
+		int32 Steps = 0;
+		for (int32 Landmark = 0; Landmark < NumLandmarks; Landmark++) {
+			if (FromDistances[Landmark] != MAX_uint16 && ToDistances[Landmark] != MAX_uint16) {
+				Steps = FMath::Max(Steps, FMath::Abs(FromDistances[Landmark] - ToDistances[Landmark]) - 1);
+			}
+		}
+		return FMath::Max(Distance, Steps * LandmarkStep);
+	}
+
+	// Run A* between NumQueries pairs of tiles in the landmarks' region, with the straight line heuristic and with
+	// landmarks, accumulating each into its own stats. Pairs are drawn from a fixed seed so results are repeatable
+	void MeasureLandmarks(int32 NumQueries, FTileNavSearchStats& OutPlainStats, FTileNavSearchStats& OutLandmarkStats) const;
+
+	FORCEINLINE int32 GetRegion(const int32 Index) const { return Regions.IsValidIndex(Index) ? Regions[Index] : INDEX_NONE; }
+
+	// False only when a search between the tiles is certain to fail, because they lie in different regions. A start
+	// tile that is not walkable itself is checked through its walkable neighbors
+	bool CanReach(int32 StartIndex, int32 EndIndex) const;
+
+	// Whether every tile under the straight line between two tiles is walkable. Lines passing exactly through a corner
+	// need both tiles beside the corner to be walkable
+	bool HasLineOfSight(int32 StartIndex, int32 EndIndex, uint8 MinClearance = 0) const;
+
+	// Recompute NeighborOffsets for the current width
+	void UpdateNeighborOffsets();
+
+	SIZE_T GetAllocatedSize() const;
+
+	// Search between two tiles. Appends the tile indices of the path, including both ends, to OutPath. Tiles below
+	// MinClearance are treated as blocked. Unless bAllowBidirectional is false, long A* searches run bidirectionally
+	bool FindPath(int32 StartIndex, int32 EndIndex, ETileNavSearchMode Mode, TArray<int32>& OutPath, FTileNavSearchStats& Stats, uint8 MinClearance = 0, bool bAllowBidirectional = true) const;
+
+	// Whether a search between two tiles would run from both ends. Only plain A* does, in sections without landmarks,
+	// since the landmark heuristic already narrows the search further than meeting in the middle
+	bool IsBidirectional(int32 StartIndex, int32 EndIndex, ETileNavSearchMode Mode) const;
+
+	// Search between the tiles at two world locations, appending the tile locations of the path to PathTiles.
+	// bFound is left untouched when both locations resolve to the same tile
+	void FindPath(const FVector& Start, const FVector& End, ETileNavSearchMode Mode, bool& bFound, TArray<FVector>& PathTiles, FTileNavSearchStats& Stats, uint8 MinClearance = 0) const;
+
+private:
+	bool FindPathAStar(int32 StartIndex, int32 EndIndex, TArray<int32>& OutPath, FTileNavSearchStats& Stats, uint8 MinClearance, bool bLandmarks = true) const;
+	// NBA*. Searches forwards from the start and backwards from the end in turn, sharing one closed set, and rejects
+	// tiles that either side's estimate shows cannot improve on the shortest path through a meeting tile so far
+	bool FindPathBidirectional(int32 StartIndex, int32 EndIndex, TArray<int32>& OutPath, FTileNavSearchStats& Stats, uint8 MinClearance) const;
+	bool FindPathJumpPoint(int32 StartIndex, int32 EndIndex, TArray<int32>& OutPath, FTileNavSearchStats& Stats, uint8 MinClearance) const;
+	bool FindPathThetaStar(int32 StartIndex, int32 EndIndex, TArray<int32>& OutPath, FTileNavSearchStats& Stats, uint8 MinClearance) const;
+
+	// Walkable distance from a tile to every tile, MAX_FLT where it cannot reach
+	void ComputeTileDistances(int32 StartIndex, TArray<float>& OutDistances) const;
+
+	// Relabel the tiles of OldRegion connected to Seed as NewRegion and return how many there were
+	int32 FloodRegion(int32 Seed, int32 OldRegion, int32 NewRegion);
+	void JoinRegions(int32 Index);
+	void SplitRegion(int32 Index);
+
+	// Walks from (X, Y) in direction (Dx, Dy) and returns the first jump point found, or INDEX_NONE
+	int32 Jump(int32 X, int32 Y, int32 Dx, int32 Dy, int32 EndIndex, uint8 MinClearance) const;
+};
+
+// Tile arrays are bulk serialized, so loading baked navigation data is a straight copy into the runtime grid
+TILENAV_API FArchive& operator<<(FArchive& Ar, FTileNavGrid& Grid);
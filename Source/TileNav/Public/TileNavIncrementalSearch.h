@@ -0,0 +1,97 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "TileNavStructs.h"
+#include "TileNavSnapshot.h"
+
+/**
+ * D* Lite search between two tiles of a section, kept alive so that the path can be repaired when tiles change.
+ * The search runs backwards from the goal, so the start can move with the agent, and a repair only revisits the
+ * tiles whose distance to the goal was changed by the update. Only safe to use from one thread at a time.
+ */
+class TILENAV_API FTileNavIncrementalSearch {
+public:
+	FTileNavIncrementalSearch(const FTileNavGridConstPtr& InGrid, int32 InSection, int32 InStartTile, int32 InGoalTile, uint8 InMinClearance);
+
+	// Search from scratch. Returns false if the goal cannot be reached
+	bool Search(FTileNavSearchStats& Stats);
+
+	// Adopt an updated grid for the same section, whose tiles only differ from the previous grid in the walkability of
+	// ChangedTiles, move the start to NewStartTile if it is set, and bring the search up to date. Returns false if the
+	// goal can no longer be reached
+	bool Repair(const FTileNavGridConstPtr& NewGrid, const TArray<int32>& ChangedTiles, int32 NewStartTile, FTileNavSearchStats& Stats);
+
+	// Tile indices from the start to the goal, both included, following the cheapest step from each tile
+	bool GetPath(TArray<int32>& OutPath) const;
+
+	FORCEINLINE int32 GetSection() const { return Section; }
+	FORCEINLINE int32 GetStartTile() const { return StartTile; }
+	FORCEINLINE int32 GetGoalTile() const { return GoalTile; }
+	FORCEINLINE uint8 GetMinClearance() const { return MinClearance; }
+	FORCEINLINE const FTileNavGridConstPtr& GetGrid() const { return Grid; }
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+
+	// Tiles absent from the map are unvisited, with both distances MAX_FLT
+	struct FNode {
+		float G = MAX_FLT;
+		float Rhs = MAX_FLT;
+
+		// Open entries with any other stamp are stale
+		uint32 Stamp = 0;
+		bool bOpen = false;
+	};
+
+	struct FOpenEntry {
+		float Key1;
+		float Key2;
+		int32 Tile;
+		uint32 Stamp;
+	};
+
+	struct FLowestKey {
+		FORCEINLINE bool operator()(const FOpenEntry& A, const FOpenEntry& B) const {
+			return A.Key1 < B.Key1 || (A.Key1 == B.Key1 && A.Key2 < B.Key2);
+		}
+	};
+
+	FTileNavGridConstPtr Grid;
+	int32 Section;
+	int32 StartTile;
+	int32 GoalTile;
+	uint8 MinClearance;
+
+	// Sum of the heuristic distances the start has moved, added to new keys so that older keys stay lower bounds
+	float KeyModifier;
+	int32 LastStartTile;
+
+	TMap<int32, FNode> Nodes;
+	TArray<FOpenEntry> Open;
+	uint32 NextStamp;
+
+	FORCEINLINE float GetG(const int32 Tile) const {
+		const FNode* Node = Nodes.Find(Tile);
+		return Node ? Node->G : MAX_FLT;
+	}
+	FORCEINLINE float GetRhs(const int32 Tile) const {
+		const FNode* Node = Nodes.Find(Tile);
+		return Node ? Node->Rhs : MAX_FLT;
+	}
+
+	// Cost of stepping between neighboring tiles. Only the tile stepped onto needs to be walkable, so an agent left on
+	// a blocked tile can still step off it
+	float GetCost(int32 From, int32 To) const;
+	float GetHeuristic(int32 From, int32 To) const;
+	FOpenEntry MakeEntry(int32 Tile) const;
+
+	// Cheapest step from a tile to the goal through its neighbors
+	float ComputeRhs(int32 Tile) const;
+	void SetRhs(int32 Tile, float Rhs);
+
+	// Open the tile if its distances disagree, or close it if they agree
+	void UpdateTile(int32 Tile);
+	bool ComputeShortestPath(FTileNavSearchStats& Stats);
+};
+
+typedef TSharedPtr<FTileNavIncrementalSearch, ESPMode::ThreadSafe> FTileNavIncrementalSearchPtr;
@@ -0,0 +1,31 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "NavigationData.h"
+#include "TileNavIncrementalSearch.h"
+#include "TileNavClusterRoute.h"
+
+/**
+ * Navigation path returned by TileNav queries. Remembers the sections it crosses, so that tile updates only touch
+ * the paths through them, and for paths within a single section, the search that found it, so that the path can be
+ * repaired in place rather than found again from scratch.
+ */
+struct TILENAV_API FTileNavPath : public FNavigationPath {
+	typedef FNavigationPath Super;
+
+	static const FNavPathType Type;
+
+	FTileNavPath();
+
+	TArray<int32> PathSections;
+
+	// Incremental search the path was found with, or null if the path can only be found again from scratch
+	FTileNavIncrementalSearchPtr Repair;
+
+	// Cluster route of a long path within a clustered section. The path's points beyond its refined tiles are the
+	// route's remaining entrances, until the route is refined ahead of the agent
+	FTileNavClusterRoutePtr ClusterRoute;
+
+	// Agent the path was found for, and the clearance its tiles were required to have
+	FNavAgentProperties Agent;
+	float ClearanceRadius;
+};
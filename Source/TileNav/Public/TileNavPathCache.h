@@ -0,0 +1,85 @@
+#pragma once
+#include "CoreMinimal.h"
+
+// Identifies a path by the tiles its query projected to, so that nearby queries share an entry
+struct TILENAV_API FTileNavPathCacheKey {
+	int32 StartSection;
+	int32 StartTile;
+	int32 EndSection;
+	int32 EndTile;
+	uint32 AgentHash;
+	uint8 Pruning;
+	uint8 Search;
+
+	FTileNavPathCacheKey(const int32 InStartSection, const int32 InStartTile, const int32 InEndSection, const int32 InEndTile, const uint32 InAgentHash, const uint8 InPruning, const uint8 InSearch):
+		StartSection(InStartSection), StartTile(InStartTile), EndSection(InEndSection), EndTile(InEndTile), AgentHash(InAgentHash), Pruning(InPruning), Search(InSearch) {}
+
+	FORCEINLINE bool operator==(const FTileNavPathCacheKey& Other) const {
+		return StartSection == Other.StartSection && StartTile == Other.StartTile && EndSection == Other.EndSection &&
+			EndTile == Other.EndTile && AgentHash == Other.AgentHash && Pruning == Other.Pruning && Search == Other.Search;
+	}
+
+	friend FORCEINLINE uint32 GetTypeHash(const FTileNavPathCacheKey& Key) {
+		uint32 Hash = HashCombine(GetTypeHash(Key.StartSection), GetTypeHash(Key.StartTile));
+		Hash = HashCombine(Hash, HashCombine(GetTypeHash(Key.EndSection), GetTypeHash(Key.EndTile)));
+		return HashCombine(Hash, GetTypeHash(Key.AgentHash) ^ Key.Pruning ^ (Key.Search << 8));
+	}
+};
+
+struct TILENAV_API FTileNavPathCacheStats {
+	int64 Hits = 0;
+	int64 Misses = 0;
+
+	// Entries dropped because a section on their path changed, and entries dropped to stay within the memory budget
+	int64 Invalidations = 0;
+	int64 Evictions = 0;
+
+	int32 Entries = 0;
+	SIZE_T Bytes = 0;
+};
+
+/**
+ * Least recently used cache of path results. Each entry records the generation of every section its path crosses,
+ * and is dropped on lookup once any of them has moved on. Safe to use from any thread.
+ */
+class TILENAV_API FTileNavPathCache {
+public:
+
+	// Copy the cached path for Key to PathTiles, and the sections it crosses to PathSections, if it is still current
+	// for the given section generations
+	bool Find(const FTileNavPathCacheKey& Key, const TArray<uint32>& SectionGenerations, TArray<FVector>& PathTiles, TArray<int32>& PathSections, bool& bFound);
+
+	// Cache a path along with the generations of the sections it crosses, evicting the least recently used entries
+	// to stay within MaxBytes. Nothing is cached when MaxBytes is zero
+	void Add(const FTileNavPathCacheKey& Key, const TArray<uint32>& SectionGenerations, const TArray<int32>& PathSections, const TArray<FVector>& PathTiles, bool bFound, SIZE_T MaxBytes);
+
+	void Empty();
+
+	FTileNavPathCacheStats GetStats() const;
+
+private:
+	struct FEntry {
+		FTileNavPathCacheKey Key;
+		TArray<FVector> PathTiles;
+		TArray<TPair<int32, uint32>> SectionGenerations;
+		bool bFound;
+		SIZE_T Bytes;
+
+		// Neighbors in the recency list, from most to least recently used
+		int32 Newer;
+		int32 Older;
+
+		FEntry(const FTileNavPathCacheKey& InKey): Key(InKey), bFound(false), Bytes(0), Newer(INDEX_NONE), Older(INDEX_NONE) {}
+	};
+
+	mutable FCriticalSection Lock;
+	TSparseArray<FEntry> Entries;
+	TMap<FTileNavPathCacheKey, int32> EntryIndices;
+	int32 Newest = INDEX_NONE;
+	int32 Oldest = INDEX_NONE;
+	FTileNavPathCacheStats Stats;
+
+	void Link(int32 EntryIndex);
+	void Unlink(int32 EntryIndex);
+	void Remove(int32 EntryIndex);
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "NavigationData.h"
+#include "Async/TaskGraphInterfaces.h"
+
+/**
+ * Batches asynchronous path queries for a TileNav navigation data actor. Pending queries are dispatched once
+ * per frame across task graph workers, which search the published navigation snapshot, and the results are
+ * delivered back on the game thread once the whole batch has finished.
+ */
+class TILENAV_API FTileNavQueryService {
+public:
+	FTileNavQueryService();
+	~FTileNavQueryService();
+
+	// Queue a query for the next batch. Returns the ID passed back to ResultDelegate
+	uint32 Enqueue(const FPathFindingQuery& Query, const FNavPathQueryDelegate& ResultDelegate);
+
+	// Drop a queued or in-flight query so that its delegate is never called
+	void Abort(uint32 QueryID);
+
+	// Game thread only. Delivers the results of a finished batch, then dispatches pending queries across NumWorkers tasks
+	void Tick(int32 NumWorkers, bool bLogThroughput);
+
+	// Block until the in-flight batch is done and discard everything, without calling any delegates
+	void Flush();
+
+	int32 GetNumPending() const { return PendingQueries.Num(); }
+	bool IsBusy() const { return InFlightQueries.Num() > 0; }
+
+private:
+	struct FQuery {
+		uint32 QueryID;
+		FPathFindingQuery Query;
+		FNavPathQueryDelegate ResultDelegate;
+		FPathFindingResult Result;
+
+		FQuery(): QueryID(0) {}
+	};
+
+	TArray<FQuery> PendingQueries;
+	TArray<FQuery> InFlightQueries;
+	FGraphEventArray InFlightTasks;
+	TSet<uint32> AbortedQueries;
+	double BatchStartTime;
+	int32 BatchWorkers;
+	uint32 NextQueryID;
+
+	void DeliverResults(bool bLogThroughput);
+	void DispatchPending(int32 NumWorkers);
+};
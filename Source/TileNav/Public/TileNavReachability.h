@@ -0,0 +1,27 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "TileNavGrid.h"
+
+/**
+ * Connected components across every section, merging the regions of each section that are joined through portals.
+ * Built from the region labels the grids already keep, so it only costs a pass over the regions and portals.
+ */
+struct TILENAV_API FTileNavReachability {
+
+	// Merge the regions of the given grids, indexed by section index, where null grids are removed sections
+	void Build(const TArray<TSharedPtr<const FTileNavGrid, ESPMode::ThreadSafe>>& Grids);
+
+	// Component of a region of a section, or INDEX_NONE if the region is unknown
+	FORCEINLINE int32 GetComponent(const int32 Section, const int32 Region) const {
+		const int32 Index = FirstRegions.IsValidIndex(Section) && Region != INDEX_NONE ? FirstRegions[Section] + Region : INDEX_NONE;
+		return Components.IsValidIndex(Index) ? Components[Index] : INDEX_NONE;
+	}
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+
+	// Offset of each section's regions in Components
+	TArray<int32> FirstRegions;
+	TArray<int32> Components;
+};
@@ -0,0 +1,135 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "TileNavStructs.h"
+
+namespace TileNavSearch {
+	enum class ETileState : uint8 {
+		Unvisited,
+		Open,
+		Closed
+	};
+
+	// Orders the open heap so that the tile with the lowest F is at the top
+	struct FLowestF {
+		bool operator()(const FPathTile& A, const FPathTile& B) const {
+			return A.F < B.F;
+		}
+	};
+
+	// Flat per-tile search state addressed by tile index, with a binary open heap using lazy deletion.
+	// An improved tile is pushed again and its stale heap entries are skipped when popped. Each search stamps the
+	// tiles it visits with its generation, and tiles stamped by an earlier search read as unvisited, so the arrays
+	// are reused from one search to the next without being cleared
+	struct FSearchState {
+		TArray<float> G;
+		TArray<int32> Parents;
+		TArray<ETileState> States;
+		TArray<uint32> Generations;
+		TArray<FPathTile> OpenHeap;
+		uint32 Generation = 0;
+
+		FSearchState() {}
+
+		explicit FSearchState(const int32 NumTiles) {
+			Reset(NumTiles);
+		}
+
+		// Start a new search over NumTiles tiles, growing the arrays if they are too small but never shrinking them
+		void Reset(const int32 NumTiles) {
+			if (Generations.Num() < NumTiles) {
+				G.SetNumUninitialized(NumTiles);
+				Parents.SetNumUninitialized(NumTiles);
+				States.SetNumUninitialized(NumTiles);
+				Generations.AddZeroed(NumTiles - Generations.Num());
+			}
+			OpenHeap.Reset();
+
+			// Stamps are only cleared once the generation wraps around
+			if (++Generation == 0) {
+				FMemory::Memzero(Generations.GetData(), Generations.Num() * sizeof(uint32));
+				Generation = 1;
+			}
+		}
+
+		FORCEINLINE ETileState GetState(const int32 Index) const {
+			return Generations[Index] == Generation ? States[Index] : ETileState::Unvisited;
+		}
+
+		// G of a tile visited by this search, MAX_FLT for the rest
+		FORCEINLINE float GetG(const int32 Index) const {
+			return Generations[Index] == Generation ? G[Index] : MAX_FLT;
+		}
+
+		// Open a tile, or improve it if already open. Returns false if the tile is closed or has an equal or better G
+		bool Open(const int32 Index, const int32 Parent, const float InG, const float H) {
+			const ETileState State = GetState(Index);
+			if (State == ETileState::Closed || (State == ETileState::Open && InG >= G[Index])) {
+				return false;
+			}
+			FPathTile PathTile(Index);
+			PathTile.Parent = Parent;
+			PathTile.G = InG;
+			PathTile.H = H;
+			PathTile.F = InG + H;
+			G[Index] = InG;
+			Parents[Index] = Parent;
+			States[Index] = ETileState::Open;
+			Generations[Index] = Generation;
+			OpenHeap.HeapPush(PathTile, FLowestF());
+			return true;
+		}
+
+		// Pop and close the open tile with the lowest F. Returns false once the open heap is exhausted
+		bool PopBest(FPathTile& OutPathTile) {
+			while (OpenHeap.Num() > 0) {
+				OpenHeap.HeapPop(OutPathTile, FLowestF(), false);
+				if (States[OutPathTile.Index] == ETileState::Closed || OutPathTile.G > G[OutPathTile.Index]) {
+					continue;
+				}
+				States[OutPathTile.Index] = ETileState::Closed;
+				return true;
+			}
+			return false;
+		}
+
+		// Walk the parent chain back from EndIndex and append it to the path in forward order
+		void AppendPath(const int32 EndIndex, TArray<int32>& OutPath) const {
+			int32 PathLength = 0;
+			for (int32 Index = EndIndex; Index != INDEX_NONE; Index = Parents[Index]) {
+				PathLength++;
+			}
+			const int32 PathIndex = OutPath.Num();
+			OutPath.AddUninitialized(PathLength);
+			int32 PathTileIndex = PathIndex + PathLength - 1;
+			for (int32 Index = EndIndex; Index != INDEX_NONE; Index = Parents[Index]) {
+				OutPath[PathTileIndex--] = Index;
+			}
+		}
+	};
+
+	// Search states kept by each thread, so that searches on any thread allocate nothing once the states have grown to
+	// the largest grid searched
+	static const int32 NumThreadSearchStates = 2;
+
+	// Search state Slot of the calling thread, which the caller should Reset before use. A search must be finished
+	// with its state before another search on the same thread takes the same slot
+	TILENAV_API FSearchState& GetThreadSearchState(int32 Slot = 0);
+
+	// Search states lent to searches suspended between frames, which cannot use the thread's own. Released states are
+	// kept for the next search, and no more than MaxStates are lent at once, so memory stays bounded however many
+	// searches are queued. Not thread safe
+	class TILENAV_API FSearchStatePool {
+	public:
+		explicit FSearchStatePool(int32 InMaxStates);
+
+		// A state Reset for NumTiles tiles, or null if all MaxStates are lent out
+		TUniquePtr<FSearchState> Acquire(int32 NumTiles);
+
+		void Release(TUniquePtr<FSearchState>&& State);
+
+	private:
+		TArray<TUniquePtr<FSearchState>> FreeStates;
+		int32 NumLent;
+		int32 MaxStates;
+	};
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "CoreMinimal.h"
+
+// Directed link to a neighboring section, weighted by the distance travelled from the center of one to the other
+struct TILENAV_API FTileNavSectionLink {
+	int32 Section;
+	float Cost;
+
+	FTileNavSectionLink(): Section(INDEX_NONE), Cost(MAX_FLT) {}
+	FTileNavSectionLink(const int32 InSection, const float InCost): Section(InSection), Cost(InCost) {}
+};
+
+/**
+ * All-pairs routing table over the weighted section graph. For every pair of sections it stores the next section
+ * to move to and the remaining distance, so a section route is a walk through the table rather than a search.
+ * Routes to each goal form a shortest path tree, and only the trees affected by changed links are recomputed.
+ */
+struct TILENAV_API FTileNavSectionRoutes {
+
+	// Replace the links of every section, indexed by section index, and recompute the routes to each goal whose tree
+	// uses a link that got dearer or was removed, or that a new or cheaper link could shorten. Returns the number of
+	// goals recomputed
+	int32 Update(TArray<TArray<FTileNavSectionLink>>&& NewLinks, bool bParallel);
+
+	// Sections from Start to Goal inclusive. Returns false if Goal cannot be reached
+	bool FindRoute(int32 Start, int32 Goal, TArray<int32>& OutRoute) const;
+
+	// Travel distance from a section to a goal section, or MAX_FLT if it cannot be reached
+	FORCEINLINE float GetDistance(const int32 From, const int32 Goal) const { return Distances[Goal * NumSections + From]; }
+
+	FORCEINLINE int32 Num() const { return NumSections; }
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	int32 NumSections = 0;
+	TArray<TArray<FTileNavSectionLink>> Links;
+
+	// Links into each section, used to grow a goal's tree backwards from the goal
+	TArray<TArray<FTileNavSectionLink>> ReverseLinks;
+
+	// Indexed by Goal * NumSections + From, so that the routes to each goal are contiguous
+	TArray<int32> NextHops;
+	TArray<float> Distances;
+
+	void BuildGoal(int32 Goal);
+};
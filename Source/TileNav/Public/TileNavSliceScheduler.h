@@ -0,0 +1,59 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "NavigationData.h"
+#include "TileNavSlicedSearch.h"
+
+// A sliced path query along with the path it fills and the delegates it reports to
+struct TILENAV_API FTileNavSlicedRequest {
+	uint32 QueryID;
+	int32 Priority;
+
+	// Frames since the request was last given a slice, added to its priority when scheduling
+	int32 Age;
+
+	FTileNavSlicedQueryPtr Query;
+	FNavPathSharedPtr Path;
+	FNavAgentProperties Agent;
+	float ClearanceRadius;
+	FNavPathQueryDelegate ResultDelegate;
+	FNavPathQueryDelegate PartialDelegate;
+
+	FTileNavSlicedRequest(): QueryID(0), Priority(0), Age(0), ClearanceRadius(0.0f) {}
+};
+
+/**
+ * Shares a per-frame search budget between sliced path queries on the game thread. Each pass over the pending
+ * queries gives every query one slice, highest priority first, and a query that has waited gains a level of priority
+ * for every frame it went without a slice, so low priority queries slow down under load but never stall.
+ */
+class TILENAV_API FTileNavSliceScheduler {
+public:
+
+	// Expansions a query may spend before the next query gets its turn
+	static const int32 SliceExpansions = 256;
+
+	// Queries searching at once, each holding a search state the size of its grid. The rest wait their turn
+	static const int32 MaxSearchStates = 8;
+
+	FTileNavSliceScheduler();
+
+	// Queue a request and return its query ID, which is never zero
+	uint32 Enqueue(const FTileNavSlicedRequest& Request);
+
+	// Drop a request so that it is never stepped or reported again
+	void Abort(uint32 QueryID);
+
+	// Game thread only. Hand out slices until BudgetSeconds have passed or MaxExpansions have been spent, where zero
+	// disables either limit. Requests that finished are moved to OutFinished, and requests that advanced without
+	// finishing are copied to OutAdvanced. Finished requests are appended in the order they were queued
+	void Tick(double BudgetSeconds, int32 MaxExpansions, TArray<FTileNavSlicedRequest>& OutFinished, TArray<FTileNavSlicedRequest>& OutAdvanced, FTileNavSearchStats& Stats);
+
+	void Empty();
+
+	int32 GetNumPending() const { return Requests.Num(); }
+
+private:
+	TArray<FTileNavSlicedRequest> Requests;
+	uint32 NextQueryID;
+	TileNavSearch::FSearchStatePool SearchStates;
+};
@@ -0,0 +1,90 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "TileNavStructs.h"
+#include "TileNavSnapshot.h"
+#include "TileNavSearchState.h"
+
+enum class ETileNavSearchStatus : uint8 {
+	InProgress,
+	Succeeded,
+	Failed
+};
+
+/**
+ * A* search between two tiles of a section that can be suspended after any number of expansions and resumed later.
+ * While the search is in progress, the path to the closed tile nearest the goal is available as a partial path.
+ */
+class TILENAV_API FTileNavSlicedSearch {
+public:
+	// Searches with InSearch, which must already be Reset for the grid, until its state is released
+	FTileNavSlicedSearch(const FTileNavGridConstPtr& InGrid, int32 InStartTile, int32 InEndTile, uint8 InMinClearance, TUniquePtr<TileNavSearch::FSearchState>&& InSearch);
+
+	// Expand up to MaxExpansions tiles and return the status the search is left in
+	ETileNavSearchStatus Step(int32 MaxExpansions, FTileNavSearchStats& Stats);
+
+	// Append the tile indices from the start to the goal, or to the tile nearest the goal if the search has not
+	// succeeded. Returns true if the path reaches the goal
+	bool AppendPath(TArray<int32>& OutPath) const;
+
+	// Give up the search state, after which the search has no path left to append
+	TUniquePtr<TileNavSearch::FSearchState> ReleaseSearchState();
+
+	FORCEINLINE ETileNavSearchStatus GetStatus() const { return Status; }
+
+private:
+	FTileNavGridConstPtr Grid;
+	int32 StartTile;
+	int32 EndTile;
+	uint8 MinClearance;
+	ETileNavSearchStatus Status;
+	TUniquePtr<TileNavSearch::FSearchState> Search;
+
+	// Closed tile with the lowest heuristic, where the partial path leads
+	int32 NearestTile;
+	float NearestDistance;
+};
+
+/**
+ * Path query refined one leg at a time with sliced searches, so that it can be spread over several frames. The route
+ * is planned up front against a single snapshot, which the query keeps alive until it is done.
+ */
+class TILENAV_API FTileNavSlicedQuery {
+public:
+
+	// Legs are searched in order, each over the tiles with at least ClearanceRadius clearance. A query with no legs has
+	// already failed
+	FTileNavSlicedQuery(const FTileNavSnapshotPtr& InSnapshot, const TArray<FTileNavSearchLeg>& InLegs, const TArray<int32>& InPathSections, float InClearanceRadius);
+
+	// Spend up to MaxExpansions on the current leg, moving on to the next leg once it succeeds. Each leg search borrows
+	// a state from SearchStates and returns it when the leg is over, and the query waits while none are free
+	ETileNavSearchStatus Step(int32 MaxExpansions, FTileNavSearchStats& Stats, TileNavSearch::FSearchStatePool& SearchStates);
+
+	// Return the state of the current leg search to SearchStates, for a query that is dropped before it is done
+	void ReleaseSearchState(TileNavSearch::FSearchStatePool& SearchStates);
+
+	// Tile locations of the finished legs followed by the partial path of the current one. Returns true if the path
+	// reaches the end of the route
+	bool GetPath(TArray<FVector>& OutPathTiles) const;
+
+	FORCEINLINE ETileNavSearchStatus GetStatus() const { return Status; }
+	FORCEINLINE bool IsDone() const { return Status != ETileNavSearchStatus::InProgress; }
+	FORCEINLINE const FTileNavSnapshotPtr& GetSnapshot() const { return Snapshot; }
+	FORCEINLINE const TArray<int32>& GetPathSections() const { return PathSections; }
+
+private:
+	FTileNavSnapshotPtr Snapshot;
+	TArray<FTileNavSearchLeg> Legs;
+	TArray<int32> PathSections;
+	float ClearanceRadius;
+	ETileNavSearchStatus Status;
+
+	int32 LegIndex;
+	TUniquePtr<FTileNavSlicedSearch> LegSearch;
+
+	// Tiles of the legs finished so far
+	TArray<FVector> PathTiles;
+
+	void AppendTiles(const FTileNavGrid& LegGrid, const TArray<int32>& LegTiles, TArray<FVector>& OutPathTiles) const;
+};
+
+typedef TSharedPtr<FTileNavSlicedQuery, ESPMode::ThreadSafe> FTileNavSlicedQueryPtr;
@@ -0,0 +1,102 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
+#include "TileNavStructs.h"
+#include "TileNavGrid.h"
+#include "TileNavSpatialHash.h"
+#include "TileNavSectionRoutes.h"
+#include "TileNavReachability.h"
+
+typedef TSharedPtr<const FTileNavGrid, ESPMode::ThreadSafe> FTileNavGridConstPtr;
+typedef TSharedPtr<const FTileNavBoxHash, ESPMode::ThreadSafe> FTileNavBoxHashConstPtr;
+typedef TSharedPtr<const FTileNavSectionRoutes, ESPMode::ThreadSafe> FTileNavSectionRoutesConstPtr;
+typedef TSharedPtr<const FTileNavReachability, ESPMode::ThreadSafe> FTileNavReachabilityConstPtr;
+
+// Navigation settings that path queries read. Captured on the game thread along with the snapshot, so that queries on
+// worker threads never read the navigation data's properties while they are being changed
+struct TILENAV_API FTileNavQuerySettings {
+	ETileNavSearchMode SearchMode = ETileNavSearchMode::AStar;
+	ETileNavPruningMode PruningMode = ETileNavPruningMode::Grid;
+	float Clearance = 0.0f;
+	int32 PathCacheSize = 0;
+	bool bPathPruning = false;
+	bool bValidatePrunedPaths = false;
+	bool bPortalGraphSearch = false;
+	bool bRepairActivePaths = false;
+	bool bDisplayPaths = false;
+	bool bDisplayVerboseLogs = false;
+
+	// Identifies the pruning applied to paths with these settings, zero if none, so cached paths match it
+	uint8 GetPruningKey() const { return bPathPruning ? 1 + static_cast<uint8>(PruningMode) * 2 + (bValidatePrunedPaths ? 1 : 0) : 0; }
+
+	// Identifies the search mode and section routing used with these settings, so cached paths match them
+	uint8 GetSearchKey() const { return static_cast<uint8>(SearchMode) * 2 + (bPortalGraphSearch ? 1 : 0); }
+
+	bool operator==(const FTileNavQuerySettings& Other) const {
+		return SearchMode == Other.SearchMode && PruningMode == Other.PruningMode && Clearance == Other.Clearance &&
+			PathCacheSize == Other.PathCacheSize && bPathPruning == Other.bPathPruning && bValidatePrunedPaths == Other.bValidatePrunedPaths &&
+			bPortalGraphSearch == Other.bPortalGraphSearch && bRepairActivePaths == Other.bRepairActivePaths &&
+			bDisplayPaths == Other.bDisplayPaths && bDisplayVerboseLogs == Other.bDisplayVerboseLogs;
+	}
+	bool operator!=(const FTileNavQuerySettings& Other) const { return !(*this == Other); }
+};
+
+/**
+ * Read-only view of the navigation graph that path queries run against. A new snapshot is published whenever
+ * sections are rebuilt or tiles change, so queries on worker threads always see a consistent graph while the
+ * game thread carries on modifying its own copy.
+ */
+struct TILENAV_API FTileNavSnapshot {
+	TArray<FTileNavSection> Sections;
+
+	// Tile grid for each section, indexed by section index
+	TArray<FTileNavGridConstPtr> Grids;
+
+	// Padded tile bounds of each section, by section index. Shared between snapshots until sections are rebuilt
+	FTileNavBoxHashConstPtr SectionBounds;
+
+	// Weighted routes between sections. Shared between snapshots until links or tiles change
+	FTileNavSectionRoutesConstPtr SectionRoutes;
+
+	// Connected components across linked sections, built from the region labels of the grids in this snapshot
+	FTileNavReachabilityConstPtr Reachability;
+
+	int32 TileCount;
+
+	// Generation of each section's grid, by section index. Changes whenever the section is rebuilt, relinked or has
+	// its tiles updated
+	TArray<uint32> SectionGenerations;
+
+	// Collision params for path pruning sweeps, ignoring every TileNav component and its ignored components
+	FCollisionQueryParams PruningQueryParams;
+
+	// Settings of the navigation data when the snapshot was published, or last refreshed after they changed
+	FTileNavQuerySettings Settings;
+
+	FTileNavSnapshot(): TileCount(0) {}
+
+	FORCEINLINE const FTileNavGrid* GetGrid(const int32 SectionIndex) const {
+		return Grids.IsValidIndex(SectionIndex) ? Grids[SectionIndex].Get() : nullptr;
+	}
+
+	// Find the nearest walkable tile among the sections whose bounds are within Radius of the location, without
+	// querying the physics scene, with at least ClearanceRadius clearance. Returns false if no section is in range
+	bool FindNearestTile(const FVector& Location, float Radius, int32& OutSectionIndex, int32& OutTileIndex, float ClearanceRadius = 0.0f) const;
+
+	// Whether a walkable tile can reach another, in the same or another section, from their region labels. Constant
+	// time. Regions are labelled for the smallest agent, so false is certain while true still needs a search
+	bool IsReachable(int32 StartSection, int32 StartTile, int32 EndSection, int32 EndTile) const;
+
+	// Search between tiles of two sections with A* over the portal graph and list the legs of the route, from portal
+	// to portal, for refining tile by tile. Returns false if no route exists. The sections the route crosses are added
+	// to PathSections. Portals are weighed for the smallest agent
+	bool FindPortalRoute(int32 StartSection, int32 StartTile, int32 EndSection, int32 EndTile, TArray<FTileNavSearchLeg>& OutLegs, TArray<int32>& PathSections, FTileNavSearchStats& Stats, float ClearanceRadius = 0.0f) const;
+
+	// Search between tiles of two sections with A* over the portal graph, then refine the route tile by tile between
+	// the chosen portals and append it to PathTiles. Returns false if no route exists. bFound is cleared if the route
+	// could only be partly refined. The sections the route crosses are added to PathSections. Portals are weighed for
+	// the smallest agent, and each leg is refined over the tiles with at least ClearanceRadius clearance
+	bool FindPortalPath(int32 StartSection, int32 StartTile, int32 EndSection, int32 EndTile, ETileNavSearchMode Mode, bool& bFound, TArray<FVector>& PathTiles, TArray<int32>& PathSections, FTileNavSearchStats& Stats, float ClearanceRadius = 0.0f) const;
+};
+
+typedef TSharedPtr<const FTileNavSnapshot, ESPMode::ThreadSafe> FTileNavSnapshotPtr;
@@ -0,0 +1,57 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Uniform spatial hash of points in cubic cells. Used to find edge tiles near a location without comparing
+ * against every edge tile of a section.
+ */
+struct TILENAV_API FTileNavPointHash {
+	explicit FTileNavPointHash(float InCellSize = 100.0f);
+
+	void Add(const FVector& Location);
+
+	// Whether any point lies within Radius of Location. Radius must not be larger than the cell size
+	bool HasPointWithin(const FVector& Location, float Radius) const;
+
+	int32 Num() const { return NumPoints; }
+
+private:
+	float CellSize;
+	int32 NumPoints;
+	TMap<FIntVector, TArray<FVector>> Cells;
+
+	FIntVector GetCell(const FVector& Location) const;
+};
+
+/**
+ * Uniform spatial hash of axis-aligned boxes, each stored by an integer ID. Used to find candidate pairs of nearby
+ * components without testing every pair.
+ */
+struct TILENAV_API FTileNavBoxHash {
+
+	// Boxes spanning more cells than this are kept in a separate list and checked by every query
+	static const int32 MaxCellsPerBox = 4096;
+
+	explicit FTileNavBoxHash(float InCellSize = 1000.0f);
+
+	void Add(const FBox& Box, int32 ID);
+
+	// IDs of every box that intersects Box, in ascending order and without duplicates
+	void Query(const FBox& Box, TArray<int32>& OutIDs) const;
+
+	int32 Num() const { return Boxes.Num(); }
+
+private:
+	float CellSize;
+	TArray<FBox> Boxes;
+	TArray<int32> IDs;
+	TArray<int32> OversizedBoxes;
+
+	// Indices into Boxes for each occupied cell
+	TMap<FIntVector, TArray<int32>> Cells;
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	// Upper bound on the number of cells a box spans
+	float GetNumCells(const FBox& Box) const;
+};
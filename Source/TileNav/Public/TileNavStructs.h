@@ -1,6 +1,28 @@
 ﻿#pragma once
 #include "TileNavStructs.generated.h"
 
+UENUM(BlueprintType)
+enum class ETileNavSearchMode : uint8 {
+	// A* over every 8-connected neighbor
+	AStar UMETA(DisplayName = "A*"),
+
+	// Jump Point Search. Skips symmetric paths on uniform grids and only returns the jump points
+	JumpPoint UMETA(DisplayName = "Jump Point Search"),
+
+	// Lazy Theta*. Any-angle search that links each tile to the farthest ancestor in line of sight, so paths come out
+	// straight without pruning and only contain their turning points
+	ThetaStar UMETA(DisplayName = "Lazy Theta*")
+};
+
+UENUM(BlueprintType)
+enum class ETileNavPruningMode : uint8 {
+	// Line-of-sight walks over the walkable tiles of each section. Never prunes across sections
+	Grid UMETA(DisplayName = "Grid Line of Sight"),
+
+	// Sphere sweeps against world static collision for every candidate pair of waypoints
+	Sweep UMETA(DisplayName = "Physics Sweep")
+};
+
 USTRUCT(BlueprintType)
 struct FEdgeNeighbors {
 	GENERATED_BODY()
@@ -61,30 +83,6 @@ struct TILENAV_API FTileTraceVertex {
 	}
 };
 
-USTRUCT(BlueprintType)
-struct TILENAV_API FTileNavTile {
-	GENERATED_BODY()
-
-	UPROPERTY(BlueprintReadWrite)
-	bool bWalkable;
-	
-	UPROPERTY(BlueprintReadWrite)
-	TArray<int32> Neighbors;
-
-	FTileNavTile(): bWalkable(false) {}
-
-	FTileNavTile(const bool bWalkable, const TArray<int32> Neighbors) {
-		this->bWalkable = bWalkable;
-		this->Neighbors = Neighbors;
-	}
-};
-
-FORCEINLINE FArchive& operator<<(FArchive& Ar, FTileNavTile& TileNavTile) {
-	Ar << TileNavTile.bWalkable;
-	Ar << TileNavTile.Neighbors;
-	return Ar;
-}
-
 USTRUCT(BlueprintType)
 struct TILENAV_API FPathTile {
 	GENERATED_BODY()
@@ -114,4 +112,49 @@ struct TILENAV_API FPathTile {
 	bool operator==(const FPathTile & Other) const {
 		return Other.Index == Index;
 	}
+};
+
+// Counters collected by a single tile search, used for profiling the search core
+struct TILENAV_API FTileNavSearchStats {
+	int32 Expansions;
+	double Milliseconds;
+
+	FTileNavSearchStats(): Expansions(0), Milliseconds(0.0) {}
+
+	float GetExpansionsPerMillisecond() const {
+		return Milliseconds > 0.0 ? static_cast<float>(Expansions / Milliseconds) : 0.0f;
+	}
+
+	FTileNavSearchStats& operator+=(const FTileNavSearchStats& Other) {
+		Expansions += Other.Expansions;
+		Milliseconds += Other.Milliseconds;
+		return *this;
+	}
+};
+
+// Stretch of a route searched tile by tile within a single section. Legs with the same start and end tile step
+// straight across a link into the next section
+struct TILENAV_API FTileNavSearchLeg {
+	int32 Section;
+	int32 StartTile;
+	int32 EndTile;
+
+	FTileNavSearchLeg(): Section(INDEX_NONE), StartTile(INDEX_NONE), EndTile(INDEX_NONE) {}
+	FTileNavSearchLeg(const int32 InSection, const int32 InStartTile, const int32 InEndTile): Section(InSection), StartTile(InStartTile), EndTile(InEndTile) {}
+};
+
+// Wall-clock time spent in each phase of a section build
+struct TILENAV_API FTileNavBuildStats {
+	double TraceMilliseconds;
+	double ClearanceMilliseconds;
+	double MergeMilliseconds;
+
+	FTileNavBuildStats(): TraceMilliseconds(0.0), ClearanceMilliseconds(0.0), MergeMilliseconds(0.0) {}
+
+	FTileNavBuildStats& operator+=(const FTileNavBuildStats& Other) {
+		TraceMilliseconds += Other.TraceMilliseconds;
+		ClearanceMilliseconds += Other.ClearanceMilliseconds;
+		MergeMilliseconds += Other.MergeMilliseconds;
+		return *this;
+	}
 };
\ No newline at end of file
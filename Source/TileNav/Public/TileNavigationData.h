@@ -3,6 +3,13 @@
 #include "NavigationData.h"
 #include "NavigationSystem.h"
 #include "TileNavStructs.h"
+#include "TileNavSnapshot.h"
+#include "TileNavQueryService.h"
+#include "TileNavSliceScheduler.h"
+#include "TileNavSpatialHash.h"
+#include "TileNavPathCache.h"
+#include "TileNavFlowField.h"
+#include "TileNavPath.h"
 #include "TileNavigationData.generated.h"
 
 /**
@@ -25,14 +32,87 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Settings")
 	float GridScale = 1.0f;
 
+	// Build sections and sample their tiles on worker threads. The result is identical to a serial build
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Settings")
+	bool bParallelBuild = true;
+
 	// Additional clearance for tile collisions. Increase this if paths clip through obstacles 
 	UPROPERTY(BlueprintReadWrite, BlueprintReadWrite, Category = "TileNav|Settings")
 	float Clearance = 35.0f;
 	
-	// Prune paths with line-of-sight smoothing. Best used within walled areas
+	// Prune paths with line-of-sight smoothing. Best used within walled areas. Lazy Theta* paths are already straight
+	// within each section, so pruning only helps them where they cross between sections
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Settings")
 	bool bPathPruning = true;
 
+	// How pruning tests line of sight. Grid pruning walks the tiles of each section and costs no physics queries
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Settings")
+	ETileNavPruningMode PruningMode = ETileNavPruningMode::Grid;
+
+	// Confirm each shortcut taken by grid pruning with a sphere sweep, keeping the original points where it is blocked.
+	// Needed when obstacles other than TileNav components may have moved since the tiles were built
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Settings")
+	bool bValidatePrunedPaths = false;
+
+	// Load the navigation saved with the level on begin play instead of rebuilding it, as long as no TileNav component
+	// or setting has changed since it was built. Other obstacles are not checked, so rebuild paths after moving them
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Settings")
+	bool bLoadBakedData = true;
+
+	// Route across sections through the portal graph, choosing the cheapest chain of links. When disabled, sections are
+	// chained along the shortest section route and stitched together through the nearest link tiles
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Settings")
+	bool bPortalGraphSearch = true;
+
+	// Keep the search behind each path within a single section, so that tile updates repair active paths in place
+	// rather than invalidating them. Paths across sections are still invalidated and found again. Same-section paths
+	// then always use an 8-connected D* Lite search in place of SearchMode, and skip the path cache
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Settings")
+	bool bRepairActivePaths = false;
+
+	// Memory budget for cached path results, in KB. Zero disables the cache
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Settings", meta = (ClampMin = "0"))
+	int32 PathCacheSize = 1024;
+
+	// Search algorithm used within each section. Jump Point Search is fastest on large open sections
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Settings")
+	ETileNavSearchMode SearchMode = ETileNavSearchMode::AStar;
+
+	// Landmark tiles chosen in each section for the ALT heuristic, which bounds the remaining walkable distance far
+	// more tightly than the straight line in mazes and corridors. Costs two bytes per tile per landmark. Zero disables
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Settings", meta = (ClampMin = "0", ClampMax = "16"))
+	int32 NumLandmarks = 0;
+
+	// Tiles along each side of the clusters large sections are divided into. Long queries within a clustered section are
+	// searched over the cluster entrances first, then refined into tiles a cluster at a time as the agent moves along
+	// the path. Zero disables
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Settings", meta = (ClampMin = "0", ClampMax = "128"))
+	int32 ClusterSize = 0;
+
+	// Sections with fewer tiles than this are not clustered, and are always searched tile by tile
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Settings", meta = (ClampMin = "0"))
+	int32 MinClusteredTiles = 16384;
+
+	// Straight line distance beyond which A* searches within a section run from both ends at once, meeting in the
+	// middle instead of spreading one wide frontier out towards the goal. Sections with landmarks always search from the
+	// start, as the landmark heuristic narrows the search further. Zero disables, and is the default since equal cost
+	// paths can come out differently
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Settings", meta = (ClampMin = "0"))
+	float BidirectionalSearchDistance = 0.0f;
+
+	// Number of task graph workers that share each batch of async path queries. Zero uses every available worker
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Async", meta = (ClampMin = "0"))
+	int32 AsyncQueryWorkers = 0;
+
+	// Time sliced path queries may spend searching on the game thread each frame, in milliseconds. Zero removes the
+	// time limit
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Async", meta = (ClampMin = "0"))
+	float SlicedQueryBudget = 1.0f;
+
+	// Tiles sliced path queries may expand each frame. Zero removes the limit
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Async", meta = (ClampMin = "0"))
+	int32 SlicedQueryMaxExpansions = 0;
+
 #if WITH_EDITORONLY_DATA
 	// Whether to debug draw
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Debug")
@@ -62,6 +142,64 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TileNav|Debug")
 	float DebugScaleFactor = 5.0f;
 #endif
+
+	// Project a point onto the nearest walkable tile of the section under it, within Extent. Safe to call from any thread
+	virtual bool ProjectPoint(const FVector& Point, FNavLocation& OutLocation, const FVector& Extent, FSharedConstNavQueryFilter Filter = nullptr, const UObject* Querier = nullptr) const override;
+
+	// Queue a path query for the next async batch. ResultDelegate is called on the game thread once it completes
+	uint32 RequestPathAsync(const FPathFindingQuery& Query, const FNavPathQueryDelegate& ResultDelegate);
+
+	// Cancel an async query so that its result delegate is never called
+	void AbortPathAsync(uint32 QueryID);
+
+	// Queue a path query that is searched a slice at a time on the game thread, sharing the per-frame budget set by
+	// Sliced Query Budget and Sliced Query Max Expansions with other sliced queries. Higher priorities are served
+	// first. On frames where the search advanced without finishing, PartialDelegate is given the unpruned path so far,
+	// ending at the tile nearest the goal, so that agents can start moving. ResultDelegate is called once it completes
+	uint32 RequestPathSliced(const FPathFindingQuery& Query, const FNavPathQueryDelegate& ResultDelegate, int32 Priority = 0, const FNavPathQueryDelegate& PartialDelegate = FNavPathQueryDelegate());
+
+	// Cancel a sliced query so that neither of its delegates is called again
+	void AbortPathSliced(uint32 QueryID);
+
+	// Reweigh the links between sections and update the section routes they affect. Called whenever links or tiles
+	// change, before the next snapshot is published
+	void UpdateSectionRoutes();
+
+	// Publish the current sections and tile grids for queries to run against
+	void PublishSnapshot();
+
+	// Bring the active paths through a section up to date after ChangedTiles changed walkability. Repairable paths
+	// are repaired from the agent's current tile, and the rest are invalidated. Call after publishing the snapshot
+	void RepairActivePaths(int32 SectionIndex, const TArray<int32>& ChangedTiles);
+
+	// Thread-safe access to the most recently published snapshot
+	FTileNavSnapshotPtr GetSnapshot() const;
+
+	// Whether the walkable tiles nearest Start and End are connected, within a section or through linked sections.
+	// Answered from region labels without searching, so it is cheap enough for filtering many targets. A true result
+	// is for the smallest agent, and larger agents may still find the way too narrow
+	UFUNCTION(BlueprintCallable, Category = "TileNav")
+	bool IsReachable(FVector Start, FVector End) const;
+
+	// Build a flow field towards Goal across every section that can reach it, for any number of agents to sample
+	// instead of searching for their own paths. Returns null if Goal is not on a walkable tile
+	FTileNavFlowFieldPtr BuildFlowField(const FVector& Goal) const;
+
+	// Move the goal of a flow field, updating it from its previous distances. The field is rebuilt instead if any
+	// section has changed since it was built. Returns false if Goal is not on a walkable tile
+	bool MoveFlowFieldGoal(FTileNavFlowField& FlowField, const FVector& Goal) const;
+
+	// Hit, miss and eviction counters for the path cache, along with its current size
+	FTileNavPathCacheStats GetPathCacheStats() const;
+
+	// Clearance tiles are built walkable with, the smallest supported agent radius plus Clearance, and the clearance of
+	// the largest supported agent. Larger agents are kept to tiles with enough clearance for their own radius when
+	// searching, so one build serves every agent size
+	void GetAgentClearances(float& OutWalkableClearance, float& OutMaxClearance) const;
+
+	// Queue a component for an incremental rebuild on the next tick. New components are appended as new sections and
+	// unregistered ones are removed, so the indices of other sections never change
+	void MarkComponentDirty(UTileNavComponent* TileNav);
 	
 private:
 	UPROPERTY()
@@ -73,16 +211,83 @@ private:
 	UPROPERTY()
 	int32 TileCount;
 
-	static int32 GetNearestSection(const ATileNavigationData* NavGraph, const FVector Location, const float Radius);
-	static bool GetNearestEdgeTile(const FVector Location, UTileNavComponent* TileNav, UTileNavComponent* OtherTileNav, FVector& OutLocation);
-	static bool FindSectionPathInternal(const ATileNavigationData* NavGraph, const int32 Start, const int32 Goal, TArray<int32> &Path);
-	static void FindPathInternal(const ATileNavigationData* NavGraph, const FPathFindingQuery Query, bool& bFound, TArray<FVector>& PathTiles);	
-	static UTileNavComponent* GetTileNav(const ATileNavigationData* NavGraph, const int32 SectionIndex);
-	void ApplyPathPruning(TArray<FVector>& Path, const FNavAgentProperties NavAgent) const; 
+	// Checksum of the components and settings the sections were built from, saved with the baked grids
+	uint32 BuildChecksum = 0;
+
+	// Section grids loaded with the level, indexed by section index, until they are handed to their components
+	TArray<TSharedPtr<FTileNavGrid, ESPMode::ThreadSafe>> BakedGrids;
+	double BakedLoadMilliseconds = 0.0;
+
+	// Section lookup shared by every snapshot published until the sections are next rebuilt
+	FTileNavBoxHashConstPtr SectionBounds;
+
+	// Next section to move to between every pair of sections, updated in place as sections change
+	TSharedPtr<FTileNavSectionRoutes, ESPMode::ThreadSafe> SectionRoutes;
+
+	// Generation of each section's grid as of the last published snapshot
+	TArray<uint32> SectionGenerations;
+	uint32 LastSectionGeneration = 0;
+
+	FTileNavSnapshotPtr Snapshot;
+	mutable FCriticalSection SnapshotLock;
+	mutable FTileNavPathCache PathCache;
+	FTileNavQueryService QueryService;
+	FTileNavSliceScheduler SliceScheduler;
+	TSet<TWeakObjectPtr<UTileNavComponent>> DirtyComponents;
+
+	void UpdateSectionBounds();
+	void GatherComponents(TArray<UTileNavComponent*>& OutComponents) const;
+	uint32 CalculateBuildChecksum(const TArray<UTileNavComponent*>& Components) const;
+	bool LoadBakedData();
+	void RebuildDirtySections();
+	void TickSlicedQueries();
+
+	// Refine the cluster routes of active paths ahead of the agents following them
+	void RefineActivePaths();
+	void GetActivePaths(TArray<FNavPathSharedPtr>& OutPaths);
+
+	// Fill a sliced request's path with its query's current path, pruned once the query is done
+	ENavigationQueryResult::Type FillSlicedPath(const FTileNavSlicedRequest& Request) const;
+	void RelinkSections(const TSet<int32>& ChangedSections);
+	FBox GetProximityBounds(const UTileNavComponent* TileNav) const;
+
+	// Sections that pass the proximity test with each section, in ascending order. When ChangedSections is set, only
+	// pairs involving a changed section are tested
+	void FindProximalSections(const TSet<int32>* ChangedSections, TArray<TArray<int32>>& OutProximalSections) const;
+	bool AreSectionsProximal(UTileNavComponent* TileNav, UTileNavComponent* OtherNav) const;
+	static FTileNavPointHash MakeEdgeTileHash(const FTileNavGrid& Grid, const float TileProximity);
+	static bool LinkEdgeTiles(FTileNavGrid& Grid, const FTileNavPointHash& OtherEdgeTiles, const int32 OtherSectionIndex, const float TileProximity);
+
+	static bool GetNearestEdgeTile(const FVector Location, const FTileNavGrid& Grid, const int32 OtherSectionIndex, FVector& OutLocation);
+	static bool FindSectionPathInternal(const FTileNavSnapshot& NavSnapshot, const int32 Start, const int32 Goal, TArray<int32> &Path);
+	static void FindStitchedPathInternal(const ATileNavigationData* NavGraph, const FTileNavSnapshot& NavSnapshot, const int32 StartSection, const int32 EndSection, const FVector Start, const FVector End, const float ClearanceRadius, bool& bFound, TArray<FVector>& PathTiles, TArray<int32>& PathSections, FTileNavSearchStats& SearchStats);
+	static bool ProjectPathEnds(const ATileNavigationData* NavGraph, const FTileNavSnapshot& NavSnapshot, const FPathFindingQuery& Query, const float ClearanceRadius, int32& StartSection, int32& StartTile, int32& EndSection, int32& EndTile);
+
+	// Search between two projected tiles, appending the path to PathTiles and the sections it crosses to PathSections.
+	// Tiles with less than ClearanceRadius clearance are avoided
+	static void FindPathInternal(const ATileNavigationData* NavGraph, const FTileNavSnapshot& NavSnapshot, const int32 StartSection, const int32 StartTile, const int32 EndSection, const int32 EndTile, const float ClearanceRadius, bool& bFound, TArray<FVector>& PathTiles, TArray<int32>& PathSections, FTileNavSearchStats& SearchStats);	
+	// Plan a long path within a clustered section over its cluster entrances, refining the first clusters into tiles.
+	// Returns false if the query is too short to benefit, or the entrances miss the way, so tiles should be searched
+	static bool FindClusterPath(const ATileNavigationData* NavGraph, const FTileNavSnapshot& NavSnapshot, FTileNavPath& Path, const int32 Section, const int32 StartTile, const int32 EndTile, const FNavAgentProperties& NavAgent, const float ClearanceRadius, const FVector& StartLocation, bool& bFound, TArray<FVector>& PathTiles, FTileNavSearchStats& SearchStats);
+
+	// Tiles of a cluster route refined so far, pruned, followed by the entrances it has still to refine
+	static void GetClusterPathTiles(const ATileNavigationData* NavGraph, const FTileNavSnapshot& NavSnapshot, const FTileNavPath& Path, TArray<FVector>& OutPathTiles);
+	static void ApplyPathPruning(const ATileNavigationData* NavGraph, const FTileNavSnapshot& NavSnapshot, TArray<FVector>& Path, const TArray<int32>& PathSections, const FNavAgentProperties NavAgent, const float ClearanceRadius);
+	static void ApplySweepPruning(const ATileNavigationData* NavGraph, const FTileNavSnapshot& NavSnapshot, TArray<FVector>& Path, const FNavAgentProperties NavAgent);
+
+	// Bidirectional search distance for the section grids, MAX_FLT when disabled
+	float GetBidirectionalDistance() const { return BidirectionalSearchDistance > 0.0f ? BidirectionalSearchDistance : MAX_FLT; }
+
+	// Current values of the settings path queries read, for capturing in snapshots
+	FTileNavQuerySettings GetQuerySettings() const;
+
+	// Republish the current snapshot with the current settings, if they have changed since it was published
+	void RefreshQuerySettings();
 
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
 	void DebugDrawTileNav();
+	void LogLandmarks() const;
 	void DebugDrawSphere(FVector Location, float Radius, FColor Colour) const;
 	void DebugDrawBox(FVector Location, FVector Extent, FColor Colour) const;
 	void DebugDrawNumeric(FVector Location, FString String, FColor Colour) const;
@@ -93,7 +298,9 @@ protected:
 	static FPathFindingResult FindPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query);
 	ATileNavigationData(const FObjectInitializer& ObjectInitializer);
 	virtual void PostInitProperties() override;
+	virtual void Serialize(FArchive& Ar) override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickActor(float DeltaTime, enum ELevelTick TickType, FActorTickFunction& ThisTickFunction) override;
 	virtual void RebuildAll() override;
-	FVector GetNearestNavTile(UTileNavComponent* TileNavComponent, FVector Location) const;
 };